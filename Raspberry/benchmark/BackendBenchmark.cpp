@@ -0,0 +1,82 @@
+/*
+** The backend benchmark runs the whole detection of an ObjectDetector with
+** every FeatureBackend and compares how often and how fast they find the
+** target.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#include "Benchmark.hpp"
+#include "TargetModel.hpp"
+#include "ObjectDetector.hpp"
+#include "ObjectBox.hpp"
+
+/**
+ * Runs the backend benchmark. Every frame is analyzed by an ObjectDetector of
+ * every backend, which uses the brute force matcher. A frame counts as detected
+ * if the ObjectBox passes its filters, i.e. if the launcher would have used it.
+ * The recorded frames should show the target, so the detection rate is how
+ * many of them the backend recognized.
+ *
+ * arguments: <target image> <frame directory> [min hessian]
+ *
+ * @param  arguments the command line arguments of the benchmark.
+ * @return           exit code
+ */
+int runBackendBenchmark(std::vector<std::string> arguments)
+{
+    if (arguments.size() < 2) {
+        std::cout << "--backend <target image> <frame directory> [min hessian]" << std::endl;
+        return 1;
+    }
+
+    int minHessian = arguments.size() > 2 ? std::stoi(arguments[2]) : 500;
+
+    std::vector<cv::Mat>     frames   = loadFrames(arguments[1]);
+    std::vector<std::string> backends = {"surf", "orb", "brisk"};
+
+    DetectorSettings detectorSettings;
+    detectorSettings.matcherType          = TargetMatcher::bruteForce;
+    detectorSettings.ratio                = 0.75;
+    detectorSettings.keypointTarget       = 0;
+    detectorSettings.maxKeypoints         = 0;
+    detectorSettings.minHessian           = minHessian;
+    detectorSettings.maxHessian           = minHessian;
+    detectorSettings.frameDebuggingOutput = false;
+    detectorSettings.guidedMatching       = false;
+    detectorSettings.guidedRadius         = 0;
+    detectorSettings.guidedMinMatches     = 0;
+    detectorSettings.homographyModel      = HomographyEstimator::homography;
+
+    printf("\nper frame detection time (min hessian %d, ratio %.2f)\n", minHessian, detectorSettings.ratio);
+
+    for (int b = 0; b < backends.size(); b++) {
+
+        FeatureSettings featureSettings = benchmarkFeatureSettings(FeatureSettings::backendTypeWithName(backends[b]), minHessian);
+
+        // every backend gets its own cache so they do not replace each other's.
+        TargetModel    targetModel(arguments[0], arguments[0] + "." + backends[b] + ".benchmark.cache", featureSettings);
+        targetModel.setUpSURFandFLANN();
+        ObjectDetector objectDetector(&targetModel, detectorSettings);
+
+        std::vector<double> times;
+        int                 detected = 0;
+
+        for (int i = 0; i < frames.size(); i++) {
+
+            benchmarkTime start = now();
+            ObjectBox * objectBox = objectDetector.processFrameUsingSURFandFLANN(frames[i]);
+            times.push_back(millisecondsSince(start));
+
+            if (objectBox->objectDetected()) detected++;
+            delete objectBox;
+        }
+
+        printSummary(backends[b], summarize(times));
+        printf("%-28s target keypoints: %d, detected: %d of %zu frames (%.1f %%)\n", "",
+               (int) targetModel.getTargetKeypoints().size(), detected, frames.size(),
+               frames.empty() ? 0.0 : 100.0 * detected / frames.size());
+    }
+
+    return 0;
+}
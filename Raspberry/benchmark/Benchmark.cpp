@@ -0,0 +1,153 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "Benchmark.hpp"
+
+/**
+ * Loads all the images from a directory in the order of their file names.
+ * Files that are not images are skipped. If directory is a recording of the
+ * RecordingFrameSource instead, all of its frames are loaded.
+ *
+ * @param  directory the directory or recording to read from.
+ * @return           the frames in color.
+ */
+std::vector<cv::Mat> loadFrames(std::string directory)
+{
+    std::vector<std::string> fileNames;
+    std::vector<cv::Mat>     frames;
+
+    DIR * dir = opendir(directory.c_str());
+    if (dir == NULL) return loadRecordedFrames(directory);
+
+    struct dirent * entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] != '.') fileNames.push_back(entry->d_name);
+    }
+    closedir(dir);
+
+    std::sort(fileNames.begin(), fileNames.end());
+
+    for (int i = 0; i < fileNames.size(); i++) {
+        cv::Mat frame = cv::imread(directory + "/" + fileNames[i], CV_LOAD_IMAGE_COLOR);
+        if (frame.data) frames.push_back(frame);
+    }
+
+    printf("loaded %zu frames from %s\n", frames.size(), directory.c_str());
+    return frames;
+}
+
+/**
+ * Loads all the frames of a recording.
+ *
+ * @param  path the recording to read from.
+ * @return      the frames in color.
+ */
+std::vector<cv::Mat> loadRecordedFrames(std::string path)
+{
+    ReplayFrameSource    replay(path, false);
+    std::vector<cv::Mat> frames;
+
+    for (int i = 0; i < replay.getFrameCount(); i++) {
+        cv::Mat frame;
+        if (replay.read(frame)) frames.push_back(frame);
+    }
+
+    printf("loaded %zu frames from recording %s\n", frames.size(), path.c_str());
+    return frames;
+}
+
+/**
+ * Returns the current time of the monotonic clock.
+ *
+ * @return the current time
+ */
+benchmarkTime now()
+{
+    return std::chrono::steady_clock::now();
+}
+
+/**
+ * Returns the milliseconds that passed since the specified time.
+ *
+ * @param  start the time to measure from.
+ * @return       elapsed time in milliseconds.
+ */
+double millisecondsSince(benchmarkTime start)
+{
+    return std::chrono::duration<double, std::milli>(now() - start).count();
+}
+
+/**
+ * Summarizes a number of time measurements.
+ *
+ * @param  milliseconds the measurements.
+ * @return              the summary.
+ */
+TimingSummary summarize(std::vector<double> milliseconds)
+{
+    TimingSummary summary = {(int) milliseconds.size(), 0, 0, 0, 0, 0, 0};
+    if (milliseconds.empty()) return summary;
+
+    std::sort(milliseconds.begin(), milliseconds.end());
+
+    for (int i = 0; i < milliseconds.size(); i++) summary.mean += milliseconds[i];
+
+    summary.mean         /= milliseconds.size();
+    summary.median        = milliseconds[milliseconds.size() / 2];
+    summary.percentile90  = percentile(milliseconds, 90);
+    summary.percentile99  = percentile(milliseconds, 99);
+    summary.minimum       = milliseconds.front();
+    summary.maximum       = milliseconds.back();
+
+    return summary;
+}
+
+/**
+ * Returns the nearest rank percentile of sorted measurements, i.e. the
+ * smallest measurement that is at least as large as percent of them.
+ *
+ * @param  sorted  the measurements in ascending order, must not be empty.
+ * @param  percent the percentile (0 - 100).
+ * @return         the percentile.
+ */
+double percentile(const std::vector<double> & sorted, double percent)
+{
+    int rank = (int) std::ceil(percent / 100.0 * sorted.size());
+    return sorted[std::max(0, std::min(rank - 1, (int) sorted.size() - 1))];
+}
+
+/**
+ * Prints a one line summary of a measurement.
+ *
+ * @param name    the name of what was measured.
+ * @param summary the summary to print.
+ */
+void printSummary(std::string name, TimingSummary summary)
+{
+    printf("%-28s n:%5d  mean:%9.3f ms  median:%9.3f ms  p90:%9.3f ms  p99:%9.3f ms  min:%9.3f ms  max:%9.3f ms\n",
+           name.c_str(), summary.count, summary.mean, summary.median, summary.percentile90, summary.percentile99,
+           summary.minimum, summary.maximum);
+}
+
+/**
+ * Returns the feature settings the benchmarks use. They are the same as the
+ * defaults in the properties file, only the hessian threshold can be changed.
+ *
+ * @param  backend    the feature backend.
+ * @param  minHessian the SURF hessian threshold.
+ * @return            the feature settings.
+ */
+FeatureSettings benchmarkFeatureSettings(FeatureSettings::backendType backend, int minHessian)
+{
+    FeatureSettings settings;
+    settings.backend               = backend;
+    settings.minHessian            = minHessian;
+    settings.surfUpright           = false;
+    settings.orbFeatures           = 500;
+    settings.briskThreshold        = 30;
+    settings.fusedDetectAndCompute = true;
+    settings.detectionTiles        = 1;
+    settings.tileOverlap           = 128;
+    return settings;
+}
@@ -0,0 +1,58 @@
+/*!
+** The Benchmark.hpp file declares the benchmarks of the Benchmark executable
+** and the helper functions they share. Every benchmark runs on still frames
+** from a directory or a recording so the results are reproducible and no
+** hardware is needed.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <stdio.h>
+#include <dirent.h>
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "opencv2/opencv.hpp"
+#include "opencv2/highgui/highgui.hpp"
+
+#include "FeatureBackend.hpp"
+#include "ReplayFrameSource.hpp"
+#include "Exceptions.hpp"
+
+typedef std::chrono::steady_clock::time_point benchmarkTime;
+
+/**
+ * Summary of a number of time measurements in milliseconds.
+ */
+struct TimingSummary
+{
+    int    count;
+    double mean, median, percentile90, percentile99, minimum, maximum;
+};
+
+// MARK: Benchmarks
+int runMatcherBenchmark(std::vector<std::string> arguments);
+int runBruteForceBenchmark(std::vector<std::string> arguments);
+int runBackendBenchmark(std::vector<std::string> arguments);
+int runStageBenchmark(std::vector<std::string> arguments);
+int runFusedBenchmark(std::vector<std::string> arguments);
+int runTiledBenchmark(std::vector<std::string> arguments);
+int runMultiTargetBenchmark(std::vector<std::string> arguments);
+int runVocabularyBenchmark(std::vector<std::string> arguments);
+
+// MARK: Helper functions
+std::vector<cv::Mat> loadFrames(std::string directory);
+std::vector<cv::Mat> loadRecordedFrames(std::string path);
+benchmarkTime        now();
+double               millisecondsSince(benchmarkTime start);
+TimingSummary        summarize(std::vector<double> milliseconds);
+double               percentile(const std::vector<double> & sorted, double percent);
+void                 printSummary(std::string name, TimingSummary summary);
+FeatureSettings      benchmarkFeatureSettings(FeatureSettings::backendType backend, int minHessian);
+
+#endif //BENCHMARK_HPP
@@ -0,0 +1,119 @@
+/*
+** The brute force benchmark checks that every kernel of the BruteForceMatcher
+** finds the same neighbours as cv::BFMatcher and measures how long each of
+** them takes.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#include "Benchmark.hpp"
+#include "TargetModel.hpp"
+#include "BruteForceMatcher.hpp"
+
+/**
+ * Checks whether two distances are equal except for rounding. The kernels add
+ * up the elements in a different order than OpenCV does.
+ *
+ * @param  a the first distance.
+ * @param  b the second distance.
+ * @return   true if the distances are equal.
+ */
+static bool sameDistance(float a, float b)
+{
+    return std::abs(a - b) <= 1e-4 * std::max(std::abs(a), std::abs(b)) + 1e-6;
+}
+
+/**
+ * Runs the brute force benchmark. For every frame the two closest target
+ * descriptors of every scene descriptor are searched by cv::BFMatcher and by
+ * every kernel the CPU supports. A neighbour that differs from the one
+ * cv::BFMatcher found counts as a mismatch, unless both have the same distance.
+ * The backend decides whether the L2 or the Hamming kernels are checked.
+ *
+ * arguments: <target image> <frame directory> [min hessian] [backend]
+ *
+ * @param  arguments the command line arguments of the benchmark.
+ * @return           exit code, 1 if any kernel found different neighbours.
+ */
+int runBruteForceBenchmark(std::vector<std::string> arguments)
+{
+    if (arguments.size() < 2) {
+        std::cout << "--brute-force <target image> <frame directory> [min hessian] [backend]" << std::endl;
+        return 1;
+    }
+
+    int         minHessian = arguments.size() > 2 ? std::stoi(arguments[2]) : 500;
+    std::string backend    = arguments.size() > 3 ? arguments[3] : "surf";
+
+    std::vector<cv::Mat> frames = loadFrames(arguments[1]);
+
+    FeatureSettings featureSettings = benchmarkFeatureSettings(FeatureSettings::backendTypeWithName(backend), minHessian);
+
+    TargetModel targetModel(arguments[0], arguments[0] + ".benchmark.cache", featureSettings);
+    targetModel.setUpSURFandFLANN();
+    const cv::Mat & objectDescriptors = targetModel.getObjectDescriptors();
+    printf("target keypoints: %d, descriptor length: %d\n", objectDescriptors.rows, objectDescriptors.cols);
+
+    std::vector<BruteForceMatcher::kernelType> kernels;
+    for (int k = BruteForceMatcher::scalar; k <= BruteForceMatcher::neon; k++) {
+        if (BruteForceMatcher::kernelSupported((BruteForceMatcher::kernelType) k)) kernels.push_back((BruteForceMatcher::kernelType) k);
+    }
+    printf("best kernel: %s\n", BruteForceMatcher::kernelName(BruteForceMatcher::bestKernel()).c_str());
+
+    std::vector< std::vector<double> > times(kernels.size());
+    std::vector<double>                referenceTimes;
+    std::vector<long>                  mismatches(kernels.size(), 0);
+    long                               comparisons = 0;
+
+    FeatureBackend              features(featureSettings);
+    bool                        binary = targetModel.binaryDescriptors();
+    cv::BFMatcher               reference(binary ? cv::NORM_HAMMING : cv::NORM_L2);
+    cv::Mat                     sceneFrame, sceneDescriptors, indices, distances;
+    std::vector<cv::KeyPoint>   sceneKeypoints;
+    std::vector< std::vector<cv::DMatch> > referenceMatches;
+
+    for (int i = 0; i < frames.size(); i++) {
+
+        cv::cvtColor(frames[i], sceneFrame, CV_BGR2GRAY);
+        features.detectAndCompute(sceneFrame, sceneKeypoints, sceneDescriptors);
+
+        if (sceneDescriptors.rows < 1 || objectDescriptors.rows < 2) continue;
+
+        benchmarkTime start = now();
+        reference.knnMatch(sceneDescriptors, objectDescriptors, referenceMatches, 2);
+        referenceTimes.push_back(millisecondsSince(start));
+
+        for (int k = 0; k < kernels.size(); k++) {
+
+            BruteForceMatcher matcher(kernels[k]);
+
+            start = now();
+            matcher.findTwoNearest(sceneDescriptors, objectDescriptors, indices, distances);
+            times[k].push_back(millisecondsSince(start));
+
+            for (int q = 0; q < sceneDescriptors.rows; q++) {
+                for (int n = 0; n < 2; n++) {
+                    const cv::DMatch & expected = referenceMatches[q][n];
+                    float distance = binary ? distances.at<float>(q, n) : std::sqrt(distances.at<float>(q, n));
+
+                    if (indices.at<int>(q, n) != expected.trainIdx && !sameDistance(distance, expected.distance)) mismatches[k]++;
+                }
+            }
+        }
+
+        comparisons += 2 * sceneDescriptors.rows;
+    }
+
+    printf("\nper frame time of the two nearest neighbour search (%s, min hessian %d)\n", backend.c_str(), minHessian);
+    printSummary("cv::BFMatcher", summarize(referenceTimes));
+
+    int exitCode = 0;
+
+    for (int k = 0; k < kernels.size(); k++) {
+        printSummary(BruteForceMatcher::kernelName(kernels[k]), summarize(times[k]));
+        printf("%-28s mismatches: %ld of %ld\n", "", mismatches[k], comparisons);
+        if (mismatches[k] > 0) exitCode = 1;
+    }
+
+    return exitCode;
+}
@@ -0,0 +1,91 @@
+/*
+** The fused benchmark compares detecting the keypoints and calculating their
+** descriptors in a single pass with the two separate calls.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#include "Benchmark.hpp"
+#include "FeatureBackend.hpp"
+
+/**
+ * Runs the fused benchmark. Every grayscale frame is analyzed by a surf
+ * FeatureBackend with and without fused detect and compute, both with the
+ * keypoint orientation and upright. The fused pass has to find the same
+ * keypoints and descriptors as the two calls, every frame where it does not
+ * counts as a mismatch.
+ *
+ * arguments: <target image> <frames> [min hessian]
+ *
+ * @param  arguments the command line arguments of the benchmark.
+ * @return           exit code, 1 if the fused pass found different features.
+ */
+int runFusedBenchmark(std::vector<std::string> arguments)
+{
+    if (arguments.size() < 2) {
+        std::cout << "--fused <target image> <frames> [min hessian]" << std::endl;
+        return 1;
+    }
+
+    int minHessian = arguments.size() > 2 ? std::stoi(arguments[2]) : 500;
+
+    std::vector<cv::Mat> frames = loadFrames(arguments[1]);
+    std::vector<cv::Mat> grayFrames(frames.size());
+
+    for (int i = 0; i < frames.size(); i++) cv::cvtColor(frames[i], grayFrames[i], CV_BGR2GRAY);
+
+    printf("\nper frame detect and compute time (min hessian %d)\n", minHessian);
+
+    int mismatches = 0;
+
+    for (int upright = 0; upright <= 1; upright++) {
+
+        FeatureSettings separateSettings = benchmarkFeatureSettings(FeatureSettings::surf, minHessian);
+        separateSettings.surfUpright           = upright == 1;
+        separateSettings.fusedDetectAndCompute = false;
+
+        FeatureSettings fusedSettings = separateSettings;
+        fusedSettings.fusedDetectAndCompute = true;
+
+        FeatureBackend separate(separateSettings), fused(fusedSettings);
+
+        std::vector<cv::KeyPoint> separateKeypoints, fusedKeypoints;
+        cv::Mat                   separateDescriptors, fusedDescriptors;
+        std::vector<double>       separateTimes, fusedTimes;
+        long                      keypointCount     = 0;
+        int                       variantMismatches = 0;
+
+        for (int i = 0; i < grayFrames.size(); i++) {
+
+            benchmarkTime start = now();
+            separate.detectAndCompute(grayFrames[i], separateKeypoints, separateDescriptors);
+            separateTimes.push_back(millisecondsSince(start));
+
+            start = now();
+            fused.detectAndCompute(grayFrames[i], fusedKeypoints, fusedDescriptors);
+            fusedTimes.push_back(millisecondsSince(start));
+
+            keypointCount += fusedKeypoints.size();
+
+            if (separateKeypoints.size() != fusedKeypoints.size() || separateDescriptors.size() != fusedDescriptors.size()
+                || (!fusedDescriptors.empty() && cv::norm(separateDescriptors, fusedDescriptors, cv::NORM_INF) > 1e-5)) {
+                variantMismatches++;
+            }
+        }
+
+        std::string   name            = upright == 1 ? "upright" : "oriented";
+        TimingSummary separateSummary = summarize(separateTimes);
+        TimingSummary fusedSummary    = summarize(fusedTimes);
+
+        printSummary(name + " detect + compute", separateSummary);
+        printSummary(name + " fused", fusedSummary);
+        printf("%-28s keypoints per frame: %.1f, speedup: %.2fx, mismatches: %d of %zu frames\n", "",
+               grayFrames.empty() ? 0.0 : (double) keypointCount / grayFrames.size(),
+               fusedSummary.mean > 0 ? separateSummary.mean / fusedSummary.mean : 0.0,
+               variantMismatches, grayFrames.size());
+
+        mismatches += variantMismatches;
+    }
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+/*
+** The matcher benchmark compares the per frame match time of the different
+** TargetMatcher types on the same scene descriptors.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#include "Benchmark.hpp"
+#include "TargetModel.hpp"
+#include "TargetMatcher.hpp"
+
+/**
+ * Runs the matcher benchmark. The scene descriptors of every frame are
+ * calculated once and then matched by every matcher, so only the matching
+ * itself is measured. The target index is built before the measurement starts
+ * because it is only built once per run of the launcher.
+ *
+ * arguments: <target image> <frame directory> [min hessian]
+ *
+ * @param  arguments the command line arguments of the benchmark.
+ * @return           exit code
+ */
+int runMatcherBenchmark(std::vector<std::string> arguments)
+{
+    if (arguments.size() < 2) {
+        std::cout << "--matcher <target image> <frame directory> [min hessian]" << std::endl;
+        return 1;
+    }
+
+    int minHessian = arguments.size() > 2 ? std::stoi(arguments[2]) : 500;
+    float ratio    = 0.75;
+
+    std::vector<cv::Mat> frames = loadFrames(arguments[1]);
+
+    FeatureSettings featureSettings = benchmarkFeatureSettings(FeatureSettings::surf, minHessian);
+
+    TargetModel targetModel(arguments[0], arguments[0] + ".benchmark.cache", featureSettings);
+    targetModel.setUpSURFandFLANN();
+    printf("target keypoints: %d\n", targetModel.getObjectDescriptors().rows);
+
+    std::vector<std::string>   names = {"flann_scene", "flann_target", "brute_force"};
+    std::vector<TargetMatcher *> matchers;
+    std::vector< std::vector<double> > times(names.size());
+    std::vector<long> goodMatchCount(names.size(), 0);
+
+    for (int m = 0; m < names.size(); m++) {
+        matchers.push_back(new TargetMatcher(&targetModel, TargetMatcher::matcherTypeWithName(names[m]), ratio));
+    }
+
+    FeatureBackend              features(featureSettings);
+    cv::Mat                     sceneFrame, sceneDescriptors;
+    std::vector<cv::KeyPoint>   sceneKeypoints;
+    std::vector<cv::DMatch>     goodMatches;
+
+    for (int i = 0; i < frames.size(); i++) {
+
+        cv::cvtColor(frames[i], sceneFrame, CV_BGR2GRAY);
+        features.detectAndCompute(sceneFrame, sceneKeypoints, sceneDescriptors);
+
+        if (sceneDescriptors.rows < 2) continue;
+
+        for (int m = 0; m < matchers.size(); m++) {
+
+            // the first match builds the target index, which is not part of the per frame cost.
+            if (i == 0) matchers[m]->match(sceneDescriptors, goodMatches);
+
+            benchmarkTime start = now();
+            matchers[m]->match(sceneDescriptors, goodMatches);
+            times[m].push_back(millisecondsSince(start));
+            goodMatchCount[m] += goodMatches.size();
+        }
+    }
+
+    printf("\nper frame match time (min hessian %d, ratio %.2f)\n", minHessian, ratio);
+
+    for (int m = 0; m < matchers.size(); m++) {
+        printSummary(names[m], summarize(times[m]));
+        printf("%-28s good matches per frame: %.1f\n", "", times[m].empty() ? 0.0 : (double) goodMatchCount[m] / times[m].size());
+        delete matchers[m];
+    }
+
+    return 0;
+}
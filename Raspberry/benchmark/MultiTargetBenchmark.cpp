@@ -0,0 +1,118 @@
+/*
+** The multi target benchmark compares looking for several targets with one
+** ObjectDetector per target with the MultiTargetDetector, which describes
+** every frame only once and matches it against all targets at once.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#include "Benchmark.hpp"
+#include "TargetModel.hpp"
+#include "TargetLibrary.hpp"
+#include "ObjectDetector.hpp"
+#include "MultiTargetDetector.hpp"
+#include "ObjectBox.hpp"
+
+/**
+ * Runs the multi target benchmark. All frames are analyzed once by an
+ * ObjectDetector for every target, one after the other, and once by a
+ * MultiTargetDetector for all targets. Both use the same matcher and surf
+ * settings, guided matching and the keypoint budget are off so every frame
+ * costs the same. The first frame is analyzed once before the measurement so
+ * the set up of the targets and indices is not measured.
+ *
+ * arguments: <target images> <frames> [min hessian] [matcher]
+ *
+ * The target images are a comma separated list.
+ *
+ * @param  arguments the command line arguments of the benchmark.
+ * @return           exit code
+ */
+int runMultiTargetBenchmark(std::vector<std::string> arguments)
+{
+    if (arguments.size() < 2) {
+        std::cout << "--multi <target images> <frames> [min hessian] [matcher]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> targetImages = TargetLibrary::splitPaths(arguments[0]);
+    int                      minHessian   = arguments.size() > 2 ? std::stoi(arguments[2]) : 500;
+    std::string              matcher      = arguments.size() > 3 ? arguments[3] : "flann_target";
+
+    std::vector<cv::Mat> frames = loadFrames(arguments[1]);
+    if (frames.empty() || targetImages.empty()) {
+        std::cout << "No frames or no targets." << std::endl;
+        return 1;
+    }
+
+    FeatureSettings featureSettings = benchmarkFeatureSettings(FeatureSettings::surf, minHessian);
+
+    DetectorSettings detectorSettings;
+    detectorSettings.matcherType          = TargetMatcher::matcherTypeWithName(matcher);
+    detectorSettings.ratio                = 0.75;
+    detectorSettings.keypointTarget       = 0;
+    detectorSettings.maxKeypoints         = 0;
+    detectorSettings.minHessian           = minHessian;
+    detectorSettings.maxHessian           = minHessian;
+    detectorSettings.frameDebuggingOutput = false;
+    detectorSettings.guidedMatching       = false;
+    detectorSettings.guidedRadius         = 0;
+    detectorSettings.guidedMinMatches     = 0;
+    detectorSettings.homographyModel      = HomographyEstimator::homography;
+
+    int targetCount = targetImages.size();
+
+    std::vector<TargetModel *>    targetModels;
+    std::vector<ObjectDetector *> objectDetectors;
+    for (int t = 0; t < targetCount; t++) {
+        targetModels.push_back(new TargetModel(targetImages[t], targetImages[t] + ".benchmark.cache", featureSettings));
+        objectDetectors.push_back(new ObjectDetector(targetModels[t], detectorSettings));
+    }
+
+    TargetLibrary       library(targetImages, arguments[0] + ".multi.benchmark.cache", featureSettings);
+    MultiTargetDetector multiTargetDetector(&library, detectorSettings);
+
+    // set up the targets and indices.
+    for (int t = 0; t < targetCount; t++) delete objectDetectors[t]->processFrameUsingSURFandFLANN(frames[0]);
+    std::vector<ObjectBox *> warmUpBoxes = multiTargetDetector.processFrame(frames[0]);
+    for (int t = 0; t < warmUpBoxes.size(); t++) delete warmUpBoxes[t];
+
+    std::vector<double> separateTimes, multiTimes;
+    std::vector<int>    separateDetected(targetCount, 0), multiDetected(targetCount, 0);
+
+    for (int i = 0; i < frames.size(); i++) {
+
+        benchmarkTime start = now();
+        for (int t = 0; t < targetCount; t++) {
+            ObjectBox * objectBox = objectDetectors[t]->processFrameUsingSURFandFLANN(frames[i]);
+            if (objectBox->objectDetected()) separateDetected[t]++;
+            delete objectBox;
+        }
+        separateTimes.push_back(millisecondsSince(start));
+
+        start = now();
+        std::vector<ObjectBox *> objectBoxes = multiTargetDetector.processFrame(frames[i]);
+        multiTimes.push_back(millisecondsSince(start));
+
+        for (int t = 0; t < objectBoxes.size(); t++) {
+            if (objectBoxes[t]->objectDetected()) multiDetected[t]++;
+            delete objectBoxes[t];
+        }
+    }
+
+    printf("\nper frame detection time of %d targets (min hessian %d, %s)\n", targetCount, minHessian, matcher.c_str());
+    printSummary("one detector per target", summarize(separateTimes));
+    printSummary("multi target detector", summarize(multiTimes));
+
+    printf("\ndetected in %zu frames\n", frames.size());
+    for (int t = 0; t < targetCount; t++) {
+        printf("  %-40s separate %4d  multi %4d\n", targetImages[t].c_str(), separateDetected[t], multiDetected[t]);
+    }
+
+    for (int t = 0; t < targetCount; t++) {
+        delete objectDetectors[t];
+        delete targetModels[t];
+    }
+
+    return 0;
+}
@@ -0,0 +1,281 @@
+/*
+** The stage benchmark times every stage of the detection of an ObjectDetector
+** separately for a number of configurations and writes the results as JSON,
+** so the results of two builds can be compared.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#include <sstream>
+#include "Benchmark.hpp"
+#include "TargetModel.hpp"
+#include "ObjectDetector.hpp"
+#include "ObjectBox.hpp"
+
+/**
+ * The results of one configuration.
+ */
+struct StageResult
+{
+    int           minHessian;
+    double        scale;
+    std::string   matcher;
+    int           detected;
+    double        keypoints, hessianThreshold;
+    double        inliers, residual, iterations;
+    double        confidence10, confidence50, confidence90;
+    int           guided;
+    TimingSummary stages[DetectionStats::stageCount];
+    TimingSummary total;
+};
+
+/**
+ * Splits a comma separated list.
+ *
+ * @param  list the list.
+ * @return      the items.
+ */
+static std::vector<std::string> splitList(std::string list)
+{
+    std::vector<std::string> items;
+    std::stringstream        stream(list);
+    std::string              item;
+
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+/**
+ * Writes a TimingSummary as a JSON object.
+ *
+ * @param file    the file to write to.
+ * @param summary the summary.
+ */
+static void writeSummary(FILE * file, TimingSummary summary)
+{
+    fprintf(file, "{\"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"min\": %.4f, \"max\": %.4f}",
+            summary.mean, summary.median, summary.percentile90, summary.percentile99, summary.minimum, summary.maximum);
+}
+
+/**
+ * Writes the results of all configurations as JSON. All times are in
+ * milliseconds.
+ *
+ * @param file       the file to write to.
+ * @param frameCount the number of frames every configuration analyzed.
+ * @param model      the homography model of all configurations.
+ * @param results    the results.
+ */
+static void writeResults(FILE * file, int frameCount, int keypointTarget, int maxKeypoints, float guidedRadius, std::string model,
+                         const std::vector<StageResult> & results)
+{
+    fprintf(file, "{\n  \"benchmark\": \"stages\",\n  \"build\": \"%s %s\",\n  \"frames\": %d,\n", __DATE__, __TIME__, frameCount);
+    fprintf(file, "  \"keypoint_target\": %d,\n  \"max_keypoints\": %d,\n  \"guided_radius\": %.1f,\n  \"homography_model\": \"%s\",\n  \"configurations\": [\n",
+            keypointTarget, maxKeypoints, guidedRadius, model.c_str());
+
+    for (int r = 0; r < results.size(); r++) {
+        const StageResult & result = results[r];
+
+        fprintf(file, "    {\n      \"min_hessian\": %d,\n      \"scale\": %.3f,\n      \"matcher\": \"%s\",\n",
+                result.minHessian, result.scale, result.matcher.c_str());
+        fprintf(file, "      \"fps\": %.3f,\n      \"detected\": %d,\n      \"guided\": %d,\n",
+                result.total.mean > 0 ? 1000.0 / result.total.mean : 0.0, result.detected, result.guided);
+        fprintf(file, "      \"keypoints\": %.1f,\n      \"hessian_threshold\": %.1f,\n",
+                result.keypoints, result.hessianThreshold);
+        fprintf(file, "      \"inliers\": %.1f,\n      \"residual\": %.3f,\n      \"samples\": %.1f,\n",
+                result.inliers, result.residual, result.iterations);
+        fprintf(file, "      \"confidence\": {\"p10\": %.3f, \"p50\": %.3f, \"p90\": %.3f},\n      \"stages\": {\n",
+                result.confidence10, result.confidence50, result.confidence90);
+
+        for (int s = 0; s < DetectionStats::stageCount; s++) {
+            fprintf(file, "        \"%s\": ", DetectionStats::stageName(s).c_str());
+            writeSummary(file, result.stages[s]);
+            fprintf(file, s + 1 < DetectionStats::stageCount ? ",\n" : "\n");
+        }
+
+        fprintf(file, "      },\n      \"total\": ");
+        writeSummary(file, result.total);
+        fprintf(file, "\n    }%s\n", r + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(file, "  ]\n}\n");
+}
+
+/**
+ * Decides whether an ObjectBox of a scaled frame counts as a detection. The
+ * filter of the ObjectBox compares its area to the full camera frame, so the
+ * corners are scaled back to the full frame before the filter runs again.
+ *
+ * @param  objectBox the ObjectBox the detector found in the scaled frame.
+ * @param  scale     the scale of the frame.
+ * @return           does the ObjectBox represent the target at full size?
+ */
+bool detectedAtFullSize(ObjectBox * objectBox, double scale)
+{
+    if (scale == 1.0) return objectBox->objectDetected();
+
+    std::array<cv::Point2f, 4> corners = objectBox->getObjectCornerPoints();
+    for (int i = 0; i < corners.size(); i++) corners[i] *= (float) (1.0 / scale);
+
+    return ObjectBox(corners, objectBox->getConfidence()).objectDetected();
+}
+
+/**
+ * Runs the stage benchmark. Every combination of hessian threshold, frame
+ * scale and matcher analyzes all frames with an ObjectDetector that measures
+ * its stages. The frames are scaled before the measurement starts, the target
+ * always keeps its size just like on the launcher. The first frame of every
+ * configuration is analyzed once without measuring it, so the one time set up
+ * of the target index does not end up in the results.
+ * With a keypoint target the hessian threshold is adapted by the KeypointBudget,
+ * starting at the min hessian of the configuration. The keypoints and the
+ * threshold are then averaged over the frames.
+ * With a guided radius, frames after a detection are matched through the last
+ * homography, which only makes sense if the frames are a sequence.
+ *
+ * The homography model is one of the names of vp_homography_model, "homography" by default.
+ *
+ * arguments: <target image> <frames> [json file] [min hessians] [scales] [matchers] [keypoint target] [max keypoints] [guided radius] [homography model]
+ *
+ * The lists are comma separated. The JSON is written to the json file,
+ * stage_benchmark.json by default, the console only gets the readable summary.
+ * A detection in a scaled frame is judged at full size, see detectedAtFullSize().
+ *
+ * @param  arguments the command line arguments of the benchmark.
+ * @return           exit code
+ */
+int runStageBenchmark(std::vector<std::string> arguments)
+{
+    if (arguments.size() < 2) {
+        std::cout << "--stages <target image> <frames> [json file] [min hessians] [scales] [matchers] [keypoint target] [max keypoints] [guided radius] [homography model]" << std::endl;
+        return 1;
+    }
+
+    std::string              jsonPath       = arguments.size() > 2 ? arguments[2] : "stage_benchmark.json";
+    std::vector<std::string> minHessians    = splitList(arguments.size() > 3 ? arguments[3] : "300,500,800");
+    std::vector<std::string> scales         = splitList(arguments.size() > 4 ? arguments[4] : "1.0,0.5");
+    std::vector<std::string> matchers       = splitList(arguments.size() > 5 ? arguments[5] : "flann_scene,flann_target,brute_force");
+    int                      keypointTarget = arguments.size() > 6 ? std::stoi(arguments[6]) : 0;
+    int                      maxKeypoints   = arguments.size() > 7 ? std::stoi(arguments[7]) : 0;
+    float                    guidedRadius   = arguments.size() > 8 ? std::stof(arguments[8]) : 0;
+    std::string              model          = arguments.size() > 9 ? arguments[9] : "homography";
+    HomographyEstimator::modelType modelType = HomographyEstimator::modelTypeWithName(model);
+
+    std::vector<cv::Mat>     frames = loadFrames(arguments[1]);
+    std::vector<StageResult> results;
+
+    if (frames.empty()) {
+        std::cout << "no frames found in " << arguments[1] << std::endl;
+        return 1;
+    }
+
+    for (int h = 0; h < minHessians.size(); h++) {
+
+        int             minHessian      = std::stoi(minHessians[h]);
+        FeatureSettings featureSettings = benchmarkFeatureSettings(FeatureSettings::surf, minHessian);
+
+        // the cache is only valid for the hessian threshold it was written with.
+        TargetModel targetModel(arguments[0], arguments[0] + ".surf" + minHessians[h] + ".benchmark.cache", featureSettings);
+        targetModel.setUpSURFandFLANN();
+
+        for (int s = 0; s < scales.size(); s++) {
+
+            double               scale = std::stod(scales[s]);
+            std::vector<cv::Mat> scaledFrames(frames.size());
+
+            for (int i = 0; i < frames.size(); i++) {
+                if (scale == 1.0) scaledFrames[i] = frames[i];
+                else              cv::resize(frames[i], scaledFrames[i], cv::Size(), scale, scale, cv::INTER_AREA);
+            }
+
+            for (int m = 0; m < matchers.size(); m++) {
+
+                DetectorSettings detectorSettings;
+                detectorSettings.matcherType          = TargetMatcher::matcherTypeWithName(matchers[m]);
+                detectorSettings.ratio                = 0.75;
+                detectorSettings.keypointTarget       = keypointTarget;
+                detectorSettings.maxKeypoints         = maxKeypoints;
+                detectorSettings.minHessian           = 100;
+                detectorSettings.maxHessian           = 3000;
+                detectorSettings.frameDebuggingOutput = false;
+                detectorSettings.guidedMatching       = guidedRadius > 0;
+                detectorSettings.guidedRadius         = guidedRadius;
+                detectorSettings.guidedMinMatches     = 12;
+                detectorSettings.homographyModel      = modelType;
+
+                ObjectDetector objectDetector(&targetModel, detectorSettings);
+
+                delete objectDetector.processFrameUsingSURFandFLANN(scaledFrames[0]);
+                objectDetector.measureStages(true);
+
+                std::vector<double> stageTimes[DetectionStats::stageCount];
+                std::vector<double> totalTimes;
+                int                 detected  = 0, guided = 0;
+                double              keypoints = 0, hessianThreshold = 0;
+                double              inliers   = 0, residual = 0, iterations = 0;
+                std::vector<double> confidences;
+
+                for (int i = 0; i < scaledFrames.size(); i++) {
+
+                    benchmarkTime start = now();
+                    ObjectBox * objectBox = objectDetector.processFrameUsingSURFandFLANN(scaledFrames[i]);
+                    totalTimes.push_back(millisecondsSince(start));
+
+                    DetectionStats stats = objectDetector.getStats();
+                    for (int t = 0; t < DetectionStats::stageCount; t++) stageTimes[t].push_back(stats.milliseconds[t]);
+                    keypoints        += stats.keypoints;
+                    hessianThreshold += stats.hessianThreshold;
+                    inliers          += stats.inliers;
+                    residual         += stats.residual;
+                    iterations       += stats.iterations;
+                    if (stats.guided) guided++;
+
+                    if (detectedAtFullSize(objectBox, scale)) {
+                        detected++;
+                        confidences.push_back(objectBox->getConfidence());
+                    }
+                    delete objectBox;
+                }
+
+                StageResult result;
+                result.minHessian       = minHessian;
+                result.scale            = scale;
+                result.matcher          = matchers[m];
+                result.detected         = detected;
+                result.guided           = guided;
+                result.keypoints        = keypoints / scaledFrames.size();
+                result.hessianThreshold = hessianThreshold / scaledFrames.size();
+                result.inliers          = inliers / scaledFrames.size();
+                result.residual         = residual / scaledFrames.size();
+                result.iterations       = iterations / scaledFrames.size();
+                std::sort(confidences.begin(), confidences.end());
+                result.confidence10     = confidences.empty() ? 0 : percentile(confidences, 10);
+                result.confidence50     = confidences.empty() ? 0 : percentile(confidences, 50);
+                result.confidence90     = confidences.empty() ? 0 : percentile(confidences, 90);
+                result.total            = summarize(totalTimes);
+                for (int t = 0; t < DetectionStats::stageCount; t++) result.stages[t] = summarize(stageTimes[t]);
+                results.push_back(result);
+
+                printf("\nmin hessian %d, scale %.2f, %s: %.1f fps, detected %d of %zu frames, %.1f keypoints, hessian threshold %.1f\n",
+                       minHessian, scale, matchers[m].c_str(),
+                       result.total.mean > 0 ? 1000.0 / result.total.mean : 0.0, detected, scaledFrames.size(),
+                       result.keypoints, result.hessianThreshold);
+                printf("%.1f inliers, residual %.2f px, %.1f samples\n", result.inliers, result.residual, result.iterations);
+                printf("confidence of the detections: p10 %.3f, median %.3f, p90 %.3f\n",
+                       result.confidence10, result.confidence50, result.confidence90);
+                for (int t = 0; t < DetectionStats::stageCount; t++) printSummary(DetectionStats::stageName(t), result.stages[t]);
+                printSummary("total", result.total);
+            }
+        }
+    }
+
+    FILE * file = fopen(jsonPath.c_str(), "w");
+    if (file == NULL) throw FileNotFoundException(jsonPath);
+    writeResults(file, frames.size(), keypointTarget, maxKeypoints, guidedRadius, model, results);
+    fclose(file);
+
+    printf("\nresults written to %s\n", jsonPath.c_str());
+    return 0;
+}
@@ -0,0 +1,164 @@
+/*
+** The tiled benchmark compares detecting surf keypoints in tiles on several
+** threads with detecting them in the whole frame.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#include <sstream>
+#include "Benchmark.hpp"
+#include "FeatureBackend.hpp"
+
+/** Positions and sizes that differ by less than this are considered the same. */
+#define TILED_POSITION_TOLERANCE 0.01
+/** Descriptors whose L2 distance is less than this are considered the same. */
+#define TILED_DESCRIPTOR_TOLERANCE 1e-4
+/** The share of keypoints the tiles have to find just like the whole frame. */
+#define TILED_REQUIRED_MATCH 0.99
+
+/**
+ * Orders keypoints from top to bottom and left to right.
+ *
+ * @param  a the first keypoint and its index.
+ * @param  b the second keypoint and its index.
+ * @return   true if a comes before b.
+ */
+static bool keypointAbove(const std::pair<cv::KeyPoint, int> & a, const std::pair<cv::KeyPoint, int> & b)
+{
+    if (a.first.pt.y != b.first.pt.y) return a.first.pt.y < b.first.pt.y;
+    return a.first.pt.x < b.first.pt.x;
+}
+
+/**
+ * Counts the keypoints of the whole frame that the tiles found at the same
+ * position, with the same size and the same descriptor.
+ *
+ * @param  keypoints        the keypoints of the whole frame.
+ * @param  descriptors      their descriptors.
+ * @param  tiledKeypoints   the keypoints of the tiles.
+ * @param  tiledDescriptors their descriptors.
+ * @return                  the number of keypoints both found.
+ */
+static int countMatchingKeypoints(const std::vector<cv::KeyPoint> & keypoints, const cv::Mat & descriptors,
+                                  const std::vector<cv::KeyPoint> & tiledKeypoints, const cv::Mat & tiledDescriptors)
+{
+    std::vector< std::pair<cv::KeyPoint, int> > sorted;
+    for (int i = 0; i < tiledKeypoints.size(); i++) sorted.push_back(std::make_pair(tiledKeypoints[i], i));
+    std::sort(sorted.begin(), sorted.end(), keypointAbove);
+
+    int matching = 0;
+
+    for (int i = 0; i < keypoints.size(); i++) {
+
+        cv::KeyPoint lowest = keypoints[i];
+        lowest.pt.y -= TILED_POSITION_TOLERANCE;
+        lowest.pt.x  = -1;
+
+        auto candidate = std::lower_bound(sorted.begin(), sorted.end(), std::make_pair(lowest, 0), keypointAbove);
+
+        for (; candidate != sorted.end() && candidate->first.pt.y <= keypoints[i].pt.y + TILED_POSITION_TOLERANCE; candidate++) {
+
+            const cv::KeyPoint & tiled = candidate->first;
+
+            if (std::abs(tiled.pt.x - keypoints[i].pt.x) > TILED_POSITION_TOLERANCE) continue;
+            if (std::abs(tiled.size - keypoints[i].size) > TILED_POSITION_TOLERANCE) continue;
+            if (cv::norm(descriptors.row(i), tiledDescriptors.row(candidate->second), cv::NORM_L2) > TILED_DESCRIPTOR_TOLERANCE) continue;
+
+            matching++;
+            break;
+        }
+    }
+
+    return matching;
+}
+
+/**
+ * Runs the tiled benchmark. Every grayscale frame is analyzed by a surf
+ * FeatureBackend as a whole and in tiles. The tiles have to find the same
+ * keypoints and descriptors as the whole frame, at least TILED_REQUIRED_MATCH
+ * of them.
+ *
+ * arguments: <target image> <frames> [min hessian] [tiles] [overlap]
+ *
+ * The tiles are a comma separated list.
+ *
+ * @param  arguments the command line arguments of the benchmark.
+ * @return           exit code, 1 if the tiles found too few of the same keypoints.
+ */
+int runTiledBenchmark(std::vector<std::string> arguments)
+{
+    if (arguments.size() < 2) {
+        std::cout << "--tiled <target image> <frames> [min hessian] [tiles] [overlap]" << std::endl;
+        return 1;
+    }
+
+    int               minHessian = arguments.size() > 2 ? std::stoi(arguments[2]) : 500;
+    std::string       tileList   = arguments.size() > 3 ? arguments[3] : "2,4";
+    int               overlap    = arguments.size() > 4 ? std::stoi(arguments[4]) : 128;
+    std::vector<int>  tileCounts;
+    std::stringstream tileStream(tileList);
+    std::string       tiles;
+
+    while (std::getline(tileStream, tiles, ',')) tileCounts.push_back(std::stoi(tiles));
+
+    std::vector<cv::Mat> frames = loadFrames(arguments[1]);
+    std::vector<cv::Mat> grayFrames(frames.size());
+
+    for (int i = 0; i < frames.size(); i++) cv::cvtColor(frames[i], grayFrames[i], CV_BGR2GRAY);
+
+    FeatureSettings wholeSettings = benchmarkFeatureSettings(FeatureSettings::surf, minHessian);
+    FeatureBackend  whole(wholeSettings);
+
+    std::vector< std::vector<cv::KeyPoint> > keypoints(grayFrames.size());
+    std::vector<cv::Mat>                     descriptors(grayFrames.size());
+    std::vector<double>                      wholeTimes;
+
+    for (int i = 0; i < grayFrames.size(); i++) {
+        benchmarkTime start = now();
+        whole.detectAndCompute(grayFrames[i], keypoints[i], descriptors[i]);
+        wholeTimes.push_back(millisecondsSince(start));
+    }
+
+    printf("\nper frame detect and compute time (min hessian %d, overlap %d, %u cores)\n",
+           minHessian, overlap, std::thread::hardware_concurrency());
+
+    TimingSummary wholeSummary = summarize(wholeTimes);
+    printSummary("whole frame", wholeSummary);
+
+    bool matched = true;
+
+    for (int t = 0; t < tileCounts.size(); t++) {
+
+        FeatureSettings tiledSettings = wholeSettings;
+        tiledSettings.detectionTiles = tileCounts[t];
+        tiledSettings.tileOverlap    = overlap;
+        FeatureBackend tiled(tiledSettings);
+
+        std::vector<cv::KeyPoint> tiledKeypoints;
+        cv::Mat                   tiledDescriptors;
+        std::vector<double>       tiledTimes;
+        long                      keypointCount = 0, tiledKeypointCount = 0, matching = 0;
+
+        for (int i = 0; i < grayFrames.size(); i++) {
+            benchmarkTime start = now();
+            tiled.detectAndCompute(grayFrames[i], tiledKeypoints, tiledDescriptors);
+            tiledTimes.push_back(millisecondsSince(start));
+
+            keypointCount      += keypoints[i].size();
+            tiledKeypointCount += tiledKeypoints.size();
+            matching           += countMatchingKeypoints(keypoints[i], descriptors[i], tiledKeypoints, tiledDescriptors);
+        }
+
+        double        share        = keypointCount == 0 ? 1.0 : (double) matching / keypointCount;
+        TimingSummary tiledSummary = summarize(tiledTimes);
+
+        printSummary(std::to_string(tileCounts[t]) + " tiles", tiledSummary);
+        printf("%-28s keypoints: %ld whole, %ld tiled, %.2f %% the same, speedup: %.2fx\n", "",
+               keypointCount, tiledKeypointCount, 100.0 * share,
+               tiledSummary.mean > 0 ? wholeSummary.mean / tiledSummary.mean : 0.0);
+
+        if (share < TILED_REQUIRED_MATCH) matched = false;
+    }
+
+    return matched ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+/*
+** The vocabulary benchmark shows how the MultiTargetDetector scales with the
+** number of targets, once matched against the combined index of all targets
+** and once against the few targets a VocabularyTree shortlists.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#include "Benchmark.hpp"
+#include "TargetLibrary.hpp"
+#include "VocabularyTree.hpp"
+#include "MultiTargetDetector.hpp"
+#include "ObjectBox.hpp"
+
+/**
+ * Analyzes all frames with a MultiTargetDetector and counts how often any
+ * target was detected. The first frame is analyzed once before the
+ * measurement so the set up of the targets and indices is not measured.
+ *
+ * @param  detector the detector.
+ * @param  frames   the frames.
+ * @param  times    the time of every frame is appended.
+ * @return          the number of detections.
+ */
+static int timeDetector(MultiTargetDetector & detector, const std::vector<cv::Mat> & frames, std::vector<double> & times)
+{
+    std::vector<ObjectBox *> warmUpBoxes = detector.processFrame(frames[0]);
+    for (int t = 0; t < warmUpBoxes.size(); t++) delete warmUpBoxes[t];
+
+    int detections = 0;
+
+    for (int i = 0; i < frames.size(); i++) {
+        benchmarkTime start = now();
+        std::vector<ObjectBox *> objectBoxes = detector.processFrame(frames[i]);
+        times.push_back(millisecondsSince(start));
+
+        for (int t = 0; t < objectBoxes.size(); t++) {
+            if (objectBoxes[t]->objectDetected()) detections++;
+            delete objectBoxes[t];
+        }
+    }
+    return detections;
+}
+
+/**
+ * Runs the vocabulary benchmark. For every target count a vocabulary is built
+ * from that many images of the target directory (in the order of their names)
+ * and the frames are analyzed by a MultiTargetDetector with the combined FLANN
+ * index of all targets and by one with the vocabulary. Target counts larger
+ * than the number of images in the directory are skipped.
+ * The index memory of the combined index is the size of the combined
+ * descriptors it is built over, the one of the vocabulary is the size of the
+ * mapped file.
+ *
+ * arguments: <target directory> <frames> [target counts] [branching] [depth] [candidates]
+ *
+ * The target counts are a comma separated list, 10,100,1000 by default.
+ *
+ * @param  arguments the command line arguments of the benchmark.
+ * @return           exit code
+ */
+int runVocabularyBenchmark(std::vector<std::string> arguments)
+{
+    if (arguments.size() < 2) {
+        std::cout << "--vocabulary <target directory> <frames> [target counts] [branching] [depth] [candidates]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> targetImages = VocabularyTree::listImages(arguments[0]);
+    std::vector<std::string> countList    = TargetLibrary::splitPaths(arguments.size() > 2 ? arguments[2] : "10,100,1000");
+    int                      branching    = arguments.size() > 3 ? std::stoi(arguments[3]) : 10;
+    int                      depth        = arguments.size() > 4 ? std::stoi(arguments[4]) : 4;
+    int                      candidates   = arguments.size() > 5 ? std::stoi(arguments[5]) : 3;
+
+    std::vector<cv::Mat> frames = loadFrames(arguments[1]);
+    if (frames.empty() || targetImages.empty()) {
+        std::cout << "No frames or no targets." << std::endl;
+        return 1;
+    }
+
+    FeatureSettings featureSettings = benchmarkFeatureSettings(FeatureSettings::surf, 500);
+
+    DetectorSettings detectorSettings;
+    detectorSettings.matcherType          = TargetMatcher::flannTarget;
+    detectorSettings.ratio                = 0.75;
+    detectorSettings.keypointTarget       = 0;
+    detectorSettings.maxKeypoints         = 0;
+    detectorSettings.minHessian           = featureSettings.minHessian;
+    detectorSettings.maxHessian           = featureSettings.minHessian;
+    detectorSettings.frameDebuggingOutput = false;
+    detectorSettings.guidedMatching       = false;
+    detectorSettings.guidedRadius         = 0;
+    detectorSettings.guidedMinMatches     = 0;
+    detectorSettings.homographyModel      = HomographyEstimator::homography;
+
+    std::string cachePath = arguments[0] + "/.benchmark.cache";
+
+    for (int c = 0; c < countList.size(); c++) {
+
+        int targetCount = std::stoi(countList[c]);
+        if (targetCount > targetImages.size()) {
+            printf("\nskipping %d targets, %s only has %zu images\n", targetCount, arguments[0].c_str(), targetImages.size());
+            continue;
+        }
+
+        std::vector<std::string> targets(targetImages.begin(), targetImages.begin() + targetCount);
+        std::string              vocabularyPath = arguments[0] + "/.benchmark." + std::to_string(targetCount) + ".vocabulary";
+
+        benchmarkTime start = now();
+        VocabularyTree::build(targets, vocabularyPath, featureSettings, branching, depth);
+        double buildTime = millisecondsSince(start);
+
+        TargetLibrary       combinedLibrary(targets, cachePath, featureSettings);
+        MultiTargetDetector combinedDetector(&combinedLibrary, detectorSettings);
+
+        VocabularyTree      vocabulary(vocabularyPath, featureSettings);
+        TargetLibrary       vocabularyLibrary(vocabulary.getTargetPaths(), cachePath, featureSettings);
+        MultiTargetDetector vocabularyDetector(&vocabularyLibrary, detectorSettings, &vocabulary, candidates);
+
+        std::vector<double> combinedTimes, vocabularyTimes;
+        int combinedDetections   = timeDetector(combinedDetector, frames, combinedTimes);
+        int vocabularyDetections = timeDetector(vocabularyDetector, frames, vocabularyTimes);
+
+        const cv::Mat & combinedDescriptors = combinedLibrary.getCombinedDescriptors();
+
+        printf("\n%d targets, %d words (branching %d, depth %d, %d candidates), built in %.0f ms\n",
+               targetCount, vocabulary.wordCount(), branching, depth, candidates, buildTime);
+        printf("  index memory: combined %8.2f MB  vocabulary %8.2f MB\n",
+               combinedDescriptors.total() * combinedDescriptors.elemSize() / 1048576.0, vocabulary.getIndexSize() / 1048576.0);
+        printSummary("combined index", summarize(combinedTimes));
+        printSummary("vocabulary shortlist", summarize(vocabularyTimes));
+        printf("  detections in %zu frames: combined %d  vocabulary %d\n", frames.size(), combinedDetections, vocabularyDetections);
+    }
+
+    return 0;
+}
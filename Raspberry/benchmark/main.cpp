@@ -0,0 +1,75 @@
+/*!
+** The main.cpp file of the Benchmark executable. It only picks the benchmark
+** that is to be run and passes the remaining arguments on to it.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#include "Benchmark.hpp"
+#include "Exceptions.hpp"
+
+/**
+ * This function prints information about the usage of the benchmark executable
+ * to the console.
+ *
+ * @param argv array that contains the arguments.
+ */
+void usage(char *argv[]) {
+    std::cout
+    << "Usage: " << argv[0] << " <benchmark> [arguments]\n"
+    << "\n"
+    << "Benchmarks:\n"
+    << "--matcher <target image> <frames> [min hessian]\n"
+    << "                      \tPer frame match time of the scene index, target index and brute force matcher.\n"
+    << "--brute-force <target image> <frames> [min hessian] [backend]\n"
+    << "                      \tValidates every brute force kernel against cv::BFMatcher and times it.\n"
+    << "--backend <target image> <frames> [min hessian]\n"
+    << "                      \tDetection rate and per frame detection time of every feature backend.\n"
+    << "--stages <target image> <frames> [json file] [min hessians] [scales] [matchers] [keypoint target] [max keypoints] [guided radius] [homography model]\n"
+    << "                      \tTimes every detection stage per configuration and writes the results as JSON.\n"
+    << "--fused <target image> <frames> [min hessian]\n"
+    << "                      \tCompares fused surf detect and compute with the two calls, oriented and upright.\n"
+    << "--tiled <target image> <frames> [min hessian] [tiles] [overlap]\n"
+    << "                      \tCompares surf detection in tiles on several threads with the whole frame.\n"
+    << "--multi <target images> <frames> [min hessian] [matcher]\n"
+    << "                      \tCompares one detector per target with the multi target detector.\n"
+    << "--vocabulary <target directory> <frames> [target counts] [branching] [depth] [candidates]\n"
+    << "                      \tPer frame time and index memory of the combined index and the vocabulary shortlist.\n"
+    << "-h,  --help           \tDisplay this message and exit.\n"
+    << "\n"
+    << "<frames> is a directory of images or a recording (vp_frame_source = \"record\").\n"
+    << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+
+    try {
+        if (argc < 2) {
+            usage(argv);
+            return 1;
+        }
+
+        std::string benchmark = argv[1];
+        std::vector<std::string> arguments(argv + 2, argv + argc);
+
+        if      (benchmark == "--matcher")     return runMatcherBenchmark(arguments);
+        else if (benchmark == "--brute-force") return runBruteForceBenchmark(arguments);
+        else if (benchmark == "--backend")     return runBackendBenchmark(arguments);
+        else if (benchmark == "--stages")      return runStageBenchmark(arguments);
+        else if (benchmark == "--fused")       return runFusedBenchmark(arguments);
+        else if (benchmark == "--tiled")       return runTiledBenchmark(arguments);
+        else if (benchmark == "--multi")       return runMultiTargetBenchmark(arguments);
+        else if (benchmark == "--vocabulary")  return runVocabularyBenchmark(arguments);
+        else if (benchmark == "-h" || benchmark == "--help") usage(argv);
+        else {
+            std::cout << "Not a valid benchmark. Run '" << argv[0] << " --help' for info about the usage." << std::endl;
+            return 1;
+        }
+    }
+    catch (Exception &e) {
+        std::cout << e.message() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*! \class BoundedQueue BoundedQueue.hpp "BoundedQueue.hpp"
+**
+** The BoundedQueue is a simple thread safe FIFO queue with a fixed capacity.
+** It connects the stages of the VideoProcessor's perception pipeline. A stage
+** that pushes into a full queue blocks until the next stage catches up, so a
+** fast stage can never run away from a slow one. Closing the queue wakes up
+** every waiting stage so the pipeline can be shut down early.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef BOUNDEDQUEUE_HPP
+#define BOUNDEDQUEUE_HPP
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+template <typename T>
+class BoundedQueue {
+
+public:
+
+    BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1), closed(false) {}
+
+    /**
+     * Appends an element to the queue. Blocks while the queue is full.
+     *
+     * @param  element to append.
+     * @return false if the queue was closed and the element was dropped.
+     */
+    bool push(T element)
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        notFull.wait(lock, [this] { return closed || elements.size() < capacity; });
+
+        if (closed) return false;
+
+        elements.push_back(std::move(element));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * Takes the oldest element from the queue. Blocks while the queue is empty.
+     *
+     * @param  element is set to the oldest element.
+     * @return false if the queue was closed and no element is left.
+     */
+    bool pop(T & element)
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        notEmpty.wait(lock, [this] { return closed || !elements.empty(); });
+
+        if (elements.empty()) return false;
+
+        element = std::move(elements.front());
+        elements.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    /**
+     * Closes the queue. Pushing is not possible anymore and popping only
+     * returns the elements that are still in the queue.
+     */
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+
+private:
+
+    size_t                  capacity;
+    bool                    closed;
+    std::deque<T>           elements;
+    std::mutex              queueMutex;
+    std::condition_variable notFull, notEmpty;
+};
+
+#endif //BOUNDEDQUEUE_HPP
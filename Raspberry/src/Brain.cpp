@@ -9,8 +9,10 @@
 
 /**
  * The constructor just sets up the class variables.
+ *
+ * @param headless if set, the camera image is not shown.
  */
-Brain::Brain(void)
+Brain::Brain(bool headless)
 {
 	Logger::debug("Brain Constructor");
 
@@ -21,6 +23,9 @@ Brain::Brain(void)
 	vehicleTurnPath = properties->getStringPropertyWithName("vehicle_turn_calibration");
 	searchStrategy  = properties->getStringPropertyWithName("robot_search_strategy");
 	positionInSearchStrategy = 0;
+	minFireConfidence = properties->getFloatPropertyWithName("robot_min_fire_confidence");
+	fireHoldRetries   = properties->getNumberPropertyWithName("robot_fire_hold_retries");
+	heldShots         = 0;
 
 	// Reinforcement Learning properties
 	alpha 			= properties->getFloatPropertyWithName("rl_alpha");
@@ -32,7 +37,7 @@ Brain::Brain(void)
 	launcherController = new LauncherController();
 	vehicleController  = new VehicleController();
 	relativePosition   = new RelativePosition();
-	videoProcessor     = new VideoProcessor(relativePosition);
+	videoProcessor     = new VideoProcessor(relativePosition, vehicleController, launcherController, headless);
 
 	currentState = Brain::roboterState::start;
 }
@@ -130,12 +135,38 @@ void Brain::stateMachineLoop()
 						break;
 
 					case goodPosition:
-						shootTarget();
+						// Only shoot at a target that was actually seen.
+						if (relativePosition->objectBoxIsPredicted()) {
+							videoProcessor->processNextFrame();
+							currentState = Brain::roboterState::frameProcessed;
+							break;
+						}
+						// A doubtful target is detected again from scratch instead of
+						// wasting a shot. The same scene keeps giving the same
+						// confidence, so after a few tries the robot moves on.
+						if (!shootTarget()) {
+							if (++heldShots > fireHoldRetries) {
+								heldShots = 0;
+								searchSystematically();
+								currentState = Brain::roboterState::movedToNewPosition;
+								break;
+							}
+							videoProcessor->discardSamples();
+							videoProcessor->processNextFrame();
+							currentState = Brain::roboterState::frameProcessed;
+							break;
+						}
+						heldShots    = 0;
 						currentState = Brain::roboterState::end;
 						break;
 
 			case movedToNewPosition:
-				videoProcessor->processNextFrame();
+				heldShots = 0;
+				// Right after a move the target can often be predicted, so the
+				// camera does not have to settle before the next decision.
+				if (!videoProcessor->predictNextFrame()) {
+					videoProcessor->processNextFrame();
+				}
 				currentState = Brain::roboterState::frameProcessed;
 				break;
 
@@ -241,12 +272,26 @@ bool Brain::evaluatePositionAndImprove()
 /**
  * This function represents an action from the state machine. It simply envoces
  * the fireing function of the launcher.
+ * Every shot costs a missile and the launcher needs seconds to reload, so with
+ * a minFireConfidence above 0 it only fires if the target was detected with at
+ * least that confidence. A minFireConfidence of 0 always fires.
+ *
+ * @return whether the launcher fired.
  */
-void Brain::shootTarget()
+bool Brain::shootTarget()
 {
+	bool targetConfirmed = relativePosition->objectDetected() && relativePosition->getConfidence() >= minFireConfidence;
+
+	if (minFireConfidence > 0 && !targetConfirmed) {
+		printf("Holding fire, target confidence %.2f is below %.2f\n",
+		       relativePosition->objectDetected() ? relativePosition->getConfidence() : 0.0f, minFireConfidence);
+		return false;
+	}
+
 	std::cout << "SHOOTing at target!" << std::endl;
 	vehicleController->executeCommand(VehicleController::vehicleCommand::stop);
 	launcherController->executeCommand(LauncherController::launcherCommand::fire);
+	return true;
 }
 
 
@@ -375,6 +420,7 @@ void Brain::runEpisode()
 	reinforcementAction action;
 	reinforcementState  state, newState;
 	readQValuesFromFile(qValuesPath);
+	heldShots = 0;
 
 	videoProcessor->processNextFrame();
 	state = observeState();
@@ -382,7 +428,27 @@ void Brain::runEpisode()
 	while (true) {
 
 		action = choseAction(state);
-		takeAction(action);
+		bool actionTaken = takeAction(action);
+
+		// A held shot at a detected target is not learned from: the Q-values
+		// of firing keep meaning what they meant without the confidence
+		// gate. Firing without any target would have been wrong either way,
+		// so that penalty is still learned. The target is detected again
+		// from scratch, and if the gate keeps holding the episode ends
+		// without a shot.
+		if (!actionTaken) {
+			if (state == reinforcementState::rl_noTargetDetected) {
+				reward = collectReward(state, action);
+				totalReward += reward;
+				updateQValues(state, state, action, reward);
+			}
+			if (++heldShots > fireHoldRetries) break;
+			videoProcessor->discardSamples();
+			videoProcessor->processNextFrame();
+			state = observeState();
+			continue;
+		}
+		heldShots = 0;
 		videoProcessor->processNextFrame();
 
 		reward = collectReward(state, action);
@@ -438,10 +504,13 @@ Brain::reinforcementAction Brain::choseAction(reinforcementState state)
  * This function exectures an action that it is passed. It therefore translates
  * the action enum it reseives into the right executing fuction from the right
  * controller instance.
+ * Firing goes through shootTarget(), so the launcher holds fire if the target
+ * is not certain enough.
  *
- * @param action to execute
+ * @param  action to execute
+ * @return        false if the launcher held fire, true otherwise.
  */
-void Brain::takeAction(reinforcementAction action)
+bool Brain::takeAction(reinforcementAction action)
 {
 	switch (action) {
 
@@ -482,9 +551,10 @@ void Brain::takeAction(reinforcementAction action)
 		break;
 
 		case rl_fire:
-		launcherController->executeCommand(LauncherController::launcherCommand::fire);
-		break;
+		return shootTarget();
 	}
+
+	return true;
 }
 
 /**
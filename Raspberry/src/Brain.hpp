@@ -47,7 +47,7 @@
 class Brain {
 
 public:
-    Brain(void);
+    Brain(bool headless = false);
     void mainLoop(void);
     void trainingLoop();
     void stateMachineLoop();
@@ -91,11 +91,13 @@ private:
     roboterState currentState;
     std::string  searchStrategy;
     int          positionInSearchStrategy;
+    float        minFireConfidence;
+    int          fireHoldRetries, heldShots;
 
     void moveRandomly();
     void searchSystematically();
     bool evaluatePositionAndImprove();
-    void shootTarget();
+    bool shootTarget();
 
     // MARK: SDL
 //#ifdef USING_SDL
@@ -148,7 +150,7 @@ private:
 
     void runEpisode();
     reinforcementAction choseAction(reinforcementState state);
-    void takeAction(reinforcementAction action);
+    bool takeAction(reinforcementAction action);
     float collectReward(reinforcementState state, reinforcementAction action);
     reinforcementState observeState();
     void  updateQValues(reinforcementState oldState, reinforcementState newState, reinforcementAction action, float reward);
@@ -0,0 +1,401 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "BruteForceMatcher.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #define BRUTE_FORCE_X86
+    #include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define BRUTE_FORCE_NEON
+    #include <arm_neon.h>
+#endif
+
+// MARK: Kernels
+
+/**
+ * Calculates the squared L2 distance of two vectors one element at a time.
+ *
+ * @param  a      the first vector.
+ * @param  b      the second vector.
+ * @param  length the number of elements of both vectors.
+ * @return        the squared distance
+ */
+static float squaredDistanceScalar(const float * a, const float * b, int length)
+{
+    float sum = 0;
+    for (int i = 0; i < length; i++) {
+        float difference = a[i] - b[i];
+        sum += difference * difference;
+    }
+    return sum;
+}
+
+#ifdef BRUTE_FORCE_X86
+
+/**
+ * SSE2 version of squaredDistanceScalar. Works on 4 floats at a time.
+ */
+__attribute__((target("sse2")))
+static float squaredDistanceSSE2(const float * a, const float * b, int length)
+{
+    __m128 sum = _mm_setzero_ps();
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4) {
+        __m128 difference = _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+        sum = _mm_add_ps(sum, _mm_mul_ps(difference, difference));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps(lanes, sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + squaredDistanceScalar(a + i, b + i, length - i);
+}
+
+/**
+ * AVX2 version of squaredDistanceScalar. Works on 8 floats at a time and uses
+ * two accumulators so consecutive fused multiply adds do not wait on each other.
+ */
+__attribute__((target("avx2,fma")))
+static float squaredDistanceAVX2(const float * a, const float * b, int length)
+{
+    __m256 sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+    int i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m256 difference0 = _mm256_sub_ps(_mm256_loadu_ps(a + i),     _mm256_loadu_ps(b + i));
+        __m256 difference1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+        sum0 = _mm256_fmadd_ps(difference0, difference0, sum0);
+        sum1 = _mm256_fmadd_ps(difference1, difference1, sum1);
+    }
+    for (; i + 8 <= length; i += 8) {
+        __m256 difference = _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+        sum0 = _mm256_fmadd_ps(difference, difference, sum0);
+    }
+
+    __m256 sum    = _mm256_add_ps(sum0, sum1);
+    __m128 half   = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    half          = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half          = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+
+    return _mm_cvtss_f32(half) + squaredDistanceScalar(a + i, b + i, length - i);
+}
+
+/**
+ * AVX-512 version of squaredDistanceScalar. Works on 16 floats at a time, the
+ * rest is handled with a masked load so no scalar loop is needed.
+ */
+__attribute__((target("avx512f")))
+static float squaredDistanceAVX512(const float * a, const float * b, int length)
+{
+    __m512 sum = _mm512_setzero_ps();
+    int i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        __m512 difference = _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+        sum = _mm512_fmadd_ps(difference, difference, sum);
+    }
+    if (i < length) {
+        __mmask16 mask = (__mmask16) ((1u << (length - i)) - 1);
+        __m512 difference = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i));
+        sum = _mm512_fmadd_ps(difference, difference, sum);
+    }
+
+    float lanes[16], total = 0;
+    _mm512_storeu_ps(lanes, sum);
+    for (int lane = 0; lane < 16; lane++) total += lanes[lane];
+    return total;
+}
+
+#endif //BRUTE_FORCE_X86
+
+#ifdef BRUTE_FORCE_NEON
+
+/**
+ * NEON version of squaredDistanceScalar. Works on 4 floats at a time.
+ */
+static float squaredDistanceNEON(const float * a, const float * b, int length)
+{
+    float32x4_t sum = vdupq_n_f32(0);
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4) {
+        float32x4_t difference = vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i));
+        sum = vmlaq_f32(sum, difference, difference);
+    }
+
+    float lanes[4];
+    vst1q_f32(lanes, sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + squaredDistanceScalar(a + i, b + i, length - i);
+}
+
+#endif //BRUTE_FORCE_NEON
+
+/**
+ * Counts the bits that differ between two binary descriptors 8 bytes at a time.
+ * Without the popcnt instruction __builtin_popcountll falls back to a bit
+ * manipulation sequence.
+ *
+ * @param  a      the first descriptor.
+ * @param  b      the second descriptor.
+ * @param  length the number of bytes of both descriptors.
+ * @return        the Hamming distance
+ */
+static int hammingDistanceScalar(const uchar * a, const uchar * b, int length)
+{
+    int distance = 0, i = 0;
+
+    for (; i + 8 <= length; i += 8) {
+        uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        distance += __builtin_popcountll(x ^ y);
+    }
+    for (; i < length; i++) distance += __builtin_popcount(a[i] ^ b[i]);
+
+    return distance;
+}
+
+#ifdef BRUTE_FORCE_X86
+
+/**
+ * hammingDistanceScalar compiled for the popcnt instruction.
+ */
+__attribute__((target("popcnt")))
+static int hammingDistancePOPCNT(const uchar * a, const uchar * b, int length)
+{
+    int distance = 0, i = 0;
+
+    for (; i + 8 <= length; i += 8) {
+        uint64_t x, y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        distance += __builtin_popcountll(x ^ y);
+    }
+    for (; i < length; i++) distance += __builtin_popcount(a[i] ^ b[i]);
+
+    return distance;
+}
+
+#endif //BRUTE_FORCE_X86
+
+#ifdef BRUTE_FORCE_NEON
+
+/**
+ * NEON version of hammingDistanceScalar. Counts the bits of 16 bytes at a time.
+ */
+static int hammingDistanceNEON(const uchar * a, const uchar * b, int length)
+{
+    uint32x4_t sum = vdupq_n_u32(0);
+    int i = 0;
+
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t bits = vcntq_u8(veorq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+        sum = vaddq_u32(sum, vpaddlq_u16(vpaddlq_u8(bits)));
+    }
+
+    uint32_t lanes[4];
+    vst1q_u32(lanes, sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + hammingDistanceScalar(a + i, b + i, length - i);
+}
+
+#endif //BRUTE_FORCE_NEON
+
+// MARK: BruteForceMatcher
+
+/**
+ * Creates a matcher that uses the best kernel the CPU supports.
+ */
+BruteForceMatcher::BruteForceMatcher() : BruteForceMatcher(bestKernel()) {}
+
+/**
+ * Creates a matcher that uses the specified kernel. If the CPU does not support
+ * it, the scalar kernel is used instead.
+ *
+ * @param kernel the kernel to calculate the distances with.
+ */
+BruteForceMatcher::BruteForceMatcher(kernelType kernel)
+{
+    Logger::debug("BruteForceMatcher Constructor");
+    this->kernel = kernelSupported(kernel) ? kernel : scalar;
+    distance        = kernelFunction(this->kernel);
+    hammingDistance = hammingKernelFunction(this->kernel);
+}
+
+/**
+ * Finds the two closest train descriptors of every query descriptor. The
+ * results have the same layout as the ones of cv::flann::Index::knnSearch with
+ * k = 2: row i of indices holds the rows of the closest and second closest
+ * train descriptor of query descriptor i, row i of distances their distances.
+ * The distances are squared L2 distances for CV_32F descriptors and Hamming
+ * distances for CV_8U descriptors. If there is only one train descriptor, the
+ * second index is -1 and the second distance FLT_MAX.
+ *
+ * @param queryDescriptors the descriptors to find the neighbours of.
+ * @param trainDescriptors the descriptors to search in, same type as queryDescriptors.
+ * @param indices          is set to a queryDescriptors.rows x 2 CV_32S matrix.
+ * @param distances        is set to a queryDescriptors.rows x 2 CV_32F matrix.
+ */
+void BruteForceMatcher::findTwoNearest(const cv::Mat & queryDescriptors, const cv::Mat & trainDescriptors, cv::Mat & indices, cv::Mat & distances)
+{
+    CV_Assert(queryDescriptors.type() == trainDescriptors.type() && queryDescriptors.cols == trainDescriptors.cols);
+    CV_Assert(queryDescriptors.type() == CV_32F || queryDescriptors.type() == CV_8U);
+
+    if (queryDescriptors.type() == CV_32F) findTwoNearestWithKernel(queryDescriptors, trainDescriptors, indices, distances, distance);
+    else                                   findTwoNearestWithKernel(queryDescriptors, trainDescriptors, indices, distances, hammingDistance);
+}
+
+/**
+ * Getter for the kernel that is used by this matcher.
+ *
+ * @return the kernel
+ */
+BruteForceMatcher::kernelType BruteForceMatcher::getKernel() { return kernel; }
+
+/**
+ * Returns the fastest kernel the CPU supports.
+ *
+ * @return the best kernel
+ */
+BruteForceMatcher::kernelType BruteForceMatcher::bestKernel()
+{
+    if (kernelSupported(avx512)) return avx512;
+    if (kernelSupported(avx2))   return avx2;
+    if (kernelSupported(sse2))   return sse2;
+    if (kernelSupported(neon))   return neon;
+    return scalar;
+}
+
+/**
+ * Checks whether a kernel was compiled in and can run on this CPU.
+ *
+ * @param  kernel the kernel to check.
+ * @return        true if the kernel can be used.
+ */
+bool BruteForceMatcher::kernelSupported(kernelType kernel)
+{
+    switch (kernel) {
+        case scalar : return true;
+#ifdef BRUTE_FORCE_X86
+        case sse2   : return __builtin_cpu_supports("sse2");
+        case avx2   : return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case avx512 : return __builtin_cpu_supports("avx512f");
+#endif
+#ifdef BRUTE_FORCE_NEON
+        case neon   : return true;
+#endif
+        default     : return false;
+    }
+}
+
+/**
+ * Returns the name of a kernel for log output.
+ *
+ * @param  kernel the kernel.
+ * @return        its name
+ */
+std::string BruteForceMatcher::kernelName(kernelType kernel)
+{
+    switch (kernel) {
+        case scalar : return "scalar";
+        case sse2   : return "sse2";
+        case avx2   : return "avx2";
+        case avx512 : return "avx512";
+        case neon   : return "neon";
+    }
+    return "unknown";
+}
+
+// MARK: PRIVATE
+
+/**
+ * The scan of findTwoNearest for one kind of descriptor.
+ *
+ * @param queryDescriptors the descriptors to find the neighbours of.
+ * @param trainDescriptors the descriptors to search in.
+ * @param indices          is set to the indices of the two closest train descriptors.
+ * @param distances        is set to their distances.
+ * @param kernel           calculates the distance of two descriptors.
+ */
+template <typename T, typename D>
+void BruteForceMatcher::findTwoNearestWithKernel(const cv::Mat & queryDescriptors, const cv::Mat & trainDescriptors, cv::Mat & indices, cv::Mat & distances, D (*kernel)(const T *, const T *, int))
+{
+    indices.create(queryDescriptors.rows, 2, CV_32S);
+    distances.create(queryDescriptors.rows, 2, CV_32F);
+
+    int length = queryDescriptors.cols;
+
+    for (int q = 0; q < queryDescriptors.rows; q++) {
+
+        const T * query     = queryDescriptors.ptr<T>(q);
+        int   closestIndex  = -1, secondClosestIndex = -1;
+        float closest       = FLT_MAX, secondClosest = FLT_MAX;
+
+        for (int t = 0; t < trainDescriptors.rows; t++) {
+
+            float d = kernel(query, trainDescriptors.ptr<T>(t), length);
+
+            if (d < closest) {
+                secondClosest      = closest;
+                secondClosestIndex = closestIndex;
+                closest            = d;
+                closestIndex       = t;
+            }
+            else if (d < secondClosest) {
+                secondClosest      = d;
+                secondClosestIndex = t;
+            }
+        }
+
+        indices.at<int>(q, 0)     = closestIndex;
+        indices.at<int>(q, 1)     = secondClosestIndex;
+        distances.at<float>(q, 0) = closest;
+        distances.at<float>(q, 1) = secondClosest;
+    }
+}
+
+/**
+ * Returns the function that implements a kernel. Kernels that were not
+ * compiled in fall back to the scalar one.
+ *
+ * @param  kernel the kernel.
+ * @return        the distance function
+ */
+BruteForceMatcher::distanceKernel BruteForceMatcher::kernelFunction(kernelType kernel)
+{
+    switch (kernel) {
+#ifdef BRUTE_FORCE_X86
+        case sse2   : return squaredDistanceSSE2;
+        case avx2   : return squaredDistanceAVX2;
+        case avx512 : return squaredDistanceAVX512;
+#endif
+#ifdef BRUTE_FORCE_NEON
+        case neon   : return squaredDistanceNEON;
+#endif
+        default     : return squaredDistanceScalar;
+    }
+}
+
+/**
+ * Returns the function that counts the Hamming distance for a kernel. The x86
+ * kernels use the popcnt instruction if the CPU has it.
+ *
+ * @param  kernel the kernel.
+ * @return        the Hamming distance function
+ */
+BruteForceMatcher::hammingKernel BruteForceMatcher::hammingKernelFunction(kernelType kernel)
+{
+    switch (kernel) {
+#ifdef BRUTE_FORCE_X86
+        case sse2   :
+        case avx2   :
+        case avx512 : return __builtin_cpu_supports("popcnt") ? hammingDistancePOPCNT : hammingDistanceScalar;
+#endif
+#ifdef BRUTE_FORCE_NEON
+        case neon   : return hammingDistanceNEON;
+#endif
+        default     : return hammingDistanceScalar;
+    }
+}
@@ -0,0 +1,72 @@
+/*! \class BruteForceMatcher BruteForceMatcher.hpp "BruteForceMatcher.hpp"
+**
+** The BruteForceMatcher finds the two closest train descriptors of every query
+** descriptor by comparing it with every single train descriptor. The target
+** only has a few hundred descriptors, so this exact scan is cheaper than
+** searching a FLANN tree and it always finds the true nearest neighbours.
+**
+** The squared L2 distance is calculated by one of multiple kernels. The best
+** kernel the CPU supports is picked at runtime:
+**
+** -avx512 and avx2 are only compiled on x86 and are used if the CPU has them.
+** -sse2 is part of every x86_64 CPU.
+** -neon is used on ARM (e.g. the Raspberry Pi) if the compiler targets NEON.
+** -scalar works everywhere and is used if nothing else is available.
+**
+** Binary descriptors (CV_8U) are compared by their Hamming distance instead,
+** which is counted with the popcnt instruction where the CPU has it (vcnt on
+** NEON). Float descriptors have to be of type CV_32F.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef BRUTEFORCEMATCHER_HPP
+#define BRUTEFORCEMATCHER_HPP
+
+#include <cfloat>
+#include <cstdint>
+#include <string>
+#include "opencv2/core/core.hpp"
+
+#include "Logger.hpp"
+
+class BruteForceMatcher {
+
+public:
+
+    enum kernelType {
+        scalar,
+        sse2,
+        avx2,
+        avx512,
+        neon
+    };
+
+    BruteForceMatcher();
+    BruteForceMatcher(kernelType kernel);
+
+    void findTwoNearest(const cv::Mat & queryDescriptors, const cv::Mat & trainDescriptors, cv::Mat & indices, cv::Mat & distances);
+
+    kernelType getKernel();
+
+    static kernelType  bestKernel();
+    static bool        kernelSupported(kernelType kernel);
+    static std::string kernelName(kernelType kernel);
+
+private:
+
+    typedef float (*distanceKernel)(const float * a, const float * b, int length);
+    typedef int   (*hammingKernel)(const uchar * a, const uchar * b, int length);
+
+    kernelType     kernel;
+    distanceKernel distance;
+    hammingKernel  hammingDistance;
+
+    template <typename T, typename D>
+    void findTwoNearestWithKernel(const cv::Mat & queryDescriptors, const cv::Mat & trainDescriptors, cv::Mat & indices, cv::Mat & distances, D (*kernel)(const T *, const T *, int));
+
+    static distanceKernel kernelFunction(kernelType kernel);
+    static hammingKernel  hammingKernelFunction(kernelType kernel);
+};
+
+#endif //BRUTEFORCEMATCHER_HPP
@@ -0,0 +1,42 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "CameraFrameSource.hpp"
+
+/**
+ * Opens the camera.
+ *
+ * @param webcamIdentifier the device number of the camera.
+ */
+CameraFrameSource::CameraFrameSource(int webcamIdentifier)
+{
+    Logger::debug("CameraFrameSource Constructor");
+
+    capture.open(webcamIdentifier);
+    if (!capture.isOpened()) {
+        throw DeviceNotFoundException("Webcam", std::to_string(webcamIdentifier));
+    }
+}
+
+/**
+ * Reads the next frame from the camera. This blocks until the camera delivers
+ * it or returns a buffered one.
+ *
+ * @param  frame is set to the frame.
+ * @return false if the camera did not deliver a frame.
+ */
+bool CameraFrameSource::read(cv::Mat & frame)
+{
+    return capture.read(frame);
+}
+
+/**
+ * A camera is always live.
+ *
+ * @return true
+ */
+bool CameraFrameSource::live()
+{
+    return true;
+}
@@ -0,0 +1,32 @@
+/*! \class CameraFrameSource CameraFrameSource.hpp "CameraFrameSource.hpp"
+**
+** The CameraFrameSource reads the frames from a camera through a
+** cv::VideoCapture.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef CAMERAFRAMESOURCE_HPP
+#define CAMERAFRAMESOURCE_HPP
+
+#include <string>
+#include "opencv2/highgui/highgui.hpp"
+
+#include "FrameSource.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+class CameraFrameSource : public FrameSource {
+
+public:
+
+    CameraFrameSource(int webcamIdentifier);
+    bool read(cv::Mat & frame);
+    bool live();
+
+private:
+
+    cv::VideoCapture capture;
+};
+
+#endif //CAMERAFRAMESOURCE_HPP
@@ -0,0 +1,195 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "Dashboard.hpp"
+
+/**
+ * Opens the window. If renderThread is set, the window is opened and driven
+ * by a render thread that is started here.
+ *
+ * @param windowName   the name of the window.
+ * @param renderThread whether to draw on a separate thread.
+ */
+Dashboard::Dashboard(std::string windowName, bool renderThread)
+{
+    Logger::debug("Dashboard Constructor");
+    this->windowName     = windowName;
+    this->renderThread   = renderThread;
+    running              = true;
+    snapshotPending      = false;
+    lastKey              = -1;
+    mouseCallback        = NULL;
+    mouseCallbackChanged = false;
+
+    if (renderThread) {
+        thread = std::thread(&Dashboard::renderLoop, this);
+    } else {
+        cv::namedWindow(windowName, 1);
+    }
+}
+
+/**
+ * Stops the render thread and waits for it to finish.
+ */
+Dashboard::~Dashboard()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    if (thread.joinable()) thread.join();
+}
+
+/**
+ * Shows a snapshot. With a render thread it replaces the snapshot waiting to
+ * be drawn and returns right away. Otherwise it is drawn right here.
+ *
+ * @param snapshot the snapshot to show, it must not share its frame with the caller.
+ */
+void Dashboard::show(DashboardSnapshot snapshot)
+{
+    if (!renderThread) {
+        render(snapshot);
+        int key = cv::waitKey(DASHBOARD_EVENT_WAIT);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (key >= 0) lastKey = key;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pendingSnapshot = snapshot;
+    snapshotPending = true;
+}
+
+/**
+ * Returns the last key that was pressed in the window and forgets it. The
+ * keys are collected while GUI events are waited for, by show() or the render
+ * thread, so this does not wait itself.
+ *
+ * @return the key code or -1 if no key was pressed.
+ */
+int Dashboard::takeKey()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    int key = lastKey;
+    lastKey = -1;
+    return key;
+}
+
+/**
+ * Registers a mouse callback for the window. With a render thread it is
+ * registered by that thread, since it owns the window.
+ *
+ * @param callback the function that is called on mouse events.
+ */
+void Dashboard::setMouseCallback(cv::MouseCallback callback)
+{
+    if (!renderThread) {
+        cv::setMouseCallback(windowName, callback, NULL);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    mouseCallback        = callback;
+    mouseCallbackChanged = true;
+}
+
+// MARK: PRIVATE
+
+/**
+ * The loop of the render thread. It draws the latest snapshot, if there is a
+ * new one, and waits for GUI events in between.
+ */
+void Dashboard::renderLoop()
+{
+    cv::namedWindow(windowName, 1);
+
+    DashboardSnapshot snapshot;
+
+    while (true) {
+        bool hasSnapshot = false;
+        cv::MouseCallback callback = NULL;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) break;
+            if (snapshotPending) {
+                snapshot        = pendingSnapshot;
+                pendingSnapshot = DashboardSnapshot();
+                snapshotPending = false;
+                hasSnapshot     = true;
+            }
+            if (mouseCallbackChanged) {
+                callback             = mouseCallback;
+                mouseCallbackChanged = false;
+            }
+        }
+
+        if (callback != NULL) cv::setMouseCallback(windowName, callback, NULL);
+        if (hasSnapshot) render(snapshot);
+
+        int key = cv::waitKey(DASHBOARD_EVENT_WAIT);
+        if (key >= 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            lastKey = key;
+        }
+    }
+
+    cv::destroyWindow(windowName);
+}
+
+/**
+ * Draws the ObjectBoxes, the search region and the statistics onto the frame
+ * of the snapshot and shows it.
+ *
+ * @param snapshot the snapshot to show.
+ */
+void Dashboard::render(DashboardSnapshot & snapshot)
+{
+    if (snapshot.frame.empty()) return;
+
+    cv::Mat & frame    = snapshot.frame;
+    cv::Point2f origin = cv::Point2f(0, 0);
+
+    if (snapshot.centerLine) {
+        cv::line(frame, cv::Point(frame.cols/2, 0), cv::Point(frame.cols/2, frame.rows), green, 1);
+    }
+
+    if (snapshot.searchRegion.area() > 0) {
+        cv::rectangle(frame, snapshot.searchRegion, blue, 1);
+    }
+
+    for (int i=0; i<snapshot.sampleBoxes.size(); i++) {
+        snapshot.sampleBoxes[i].drawBorders(frame, origin);
+    }
+
+    for (int i=0; i<snapshot.targetBoxes.size(); i++) {
+        if (!snapshot.targetBoxes[i].objectDetected()) continue;
+        snapshot.targetBoxes[i].drawBorders(frame, origin);
+        cv::putText(frame, "target " + std::to_string(i), snapshot.targetBoxes[i].getObjectCornerPoints()[0] + origin, 1, 1.0, green, 1);
+    }
+
+    if (snapshot.hasObjectBox && snapshot.objectBox.objectDetected()) {
+        snapshot.objectBox.drawBorders(frame, origin);
+        snapshot.objectBox.drawCorners(frame, origin, green, false);
+        drawText(frame, snapshot.objectBox, origin);
+    }
+
+    cv::imshow(windowName, frame);
+}
+
+/**
+ * This function draws statistics of the ObjectBox to a frame.
+ *
+ * @param frame     the frame to draw on
+ * @param objectBox the ObjectBox of the target.
+ * @param origin    the offset to draw everything to.
+ */
+void Dashboard::drawText(cv::Mat &frame, ObjectBox & objectBox, cv::Point2f origin)
+{
+    int letterThickness = 1;
+    cv::putText(frame, "area  : " +  std::to_string(objectBox.getRelativeObjectArea()),            cv::Point2f(5, 20) + origin, 1, 1.0, green, letterThickness );
+    cv::putText(frame, "deltaX: " +  std::to_string(objectBox.distanceOfObjectToCameraCenter().x), cv::Point2f(5, 40) + origin, 1, 1.0, green, letterThickness );
+    cv::putText(frame, "deltaY: " +  std::to_string(objectBox.distanceOfObjectToCameraCenter().y), cv::Point2f(5, 60) + origin, 1, 1.0, green, letterThickness );
+    cv::putText(frame, "conf  : " +  std::to_string(objectBox.getConfidence()),                    cv::Point2f(5, 80) + origin, 1, 1.0, green, letterThickness );
+}
@@ -0,0 +1,78 @@
+/*! \class Dashboard Dashboard.hpp "Dashboard.hpp"
+**
+** The Dashboard shows the camera image with the detected ObjectBoxes drawn on
+** top of it. It never looks at the VideoProcessor or the RelativePosition
+** directly. Instead it is handed a DashboardSnapshot, which holds its own copy
+** of everything that is drawn, so the snapshot can not change while it is
+** being drawn.
+**
+** With a render thread, drawing, cv::imshow() and cv::waitKey() all run on
+** that thread. show() only stores the snapshot and returns right away, so the
+** perception thread never waits for the GUI. If a new snapshot arrives before
+** the last one was drawn, the old one is skipped. Without a render thread
+** show() draws on the calling thread.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef DASHBOARD_HPP
+#define DASHBOARD_HPP
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include "opencv2/core/core.hpp"
+#include "opencv2/highgui/highgui.hpp"
+
+#include "ObjectBox.hpp"
+#include "Logger.hpp"
+
+/** Milliseconds the render thread waits for GUI events between two snapshots. */
+#define DASHBOARD_EVENT_WAIT 10
+
+/**
+ * Everything the Dashboard draws for one frame.
+ */
+struct DashboardSnapshot
+{
+    cv::Mat                frame;
+    std::vector<ObjectBox> sampleBoxes;
+    ObjectBox              objectBox;
+    bool                   hasObjectBox = false;
+    std::vector<ObjectBox> targetBoxes;  // one per target if there are several.
+    cv::Rect               searchRegion;
+    bool                   centerLine   = false;
+};
+
+class Dashboard {
+
+public:
+
+    Dashboard(std::string windowName, bool renderThread);
+    ~Dashboard();
+    void show(DashboardSnapshot snapshot);
+    int  takeKey();
+    void setMouseCallback(cv::MouseCallback callback);
+
+private:
+
+    std::string       windowName;
+    bool              renderThread, running, snapshotPending;
+    std::thread       thread;
+    std::mutex        mutex;
+    DashboardSnapshot pendingSnapshot;
+    int               lastKey;
+    cv::MouseCallback mouseCallback;
+    bool              mouseCallbackChanged;
+
+    // MARK: colors
+    cv::Scalar green = cv::Scalar(0, 255, 0);
+    cv::Scalar blue  = cv::Scalar(255, 0, 0);
+
+    void renderLoop();
+    void render(DashboardSnapshot & snapshot);
+    void drawText(cv::Mat &frame, ObjectBox & objectBox, cv::Point2f origin);
+};
+
+#endif //DASHBOARD_HPP
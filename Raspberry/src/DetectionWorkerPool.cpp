@@ -0,0 +1,102 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "DetectionWorkerPool.hpp"
+
+/**
+ * The constructor starts the worker threads.
+ *
+ * @param targetModel     the shared target all workers look for.
+ * @param settings        the settings for the workers' ObjectDetectors.
+ * @param numberOfWorkers the number of threads to start.
+ * @param sceneCache      the SceneCache the workers share, can be NULL.
+ */
+DetectionWorkerPool::DetectionWorkerPool(TargetModel * targetModel, DetectorSettings settings, int numberOfWorkers, SceneCache * sceneCache)
+    : tasks(4 * std::max(numberOfWorkers, 1))
+{
+    Logger::debug("DetectionWorkerPool Constructor");
+    this->targetModel = targetModel;
+    this->settings    = settings;
+    this->sceneCache  = sceneCache;
+
+    for (int i = 0; i < numberOfWorkers; i++) {
+        detectors.push_back(new ObjectDetector(targetModel, settings, sceneCache));
+        workers.push_back(std::thread(&DetectionWorkerPool::workerLoop, this, detectors[i]));
+    }
+}
+
+/**
+ * The destructor lets the workers finish the frames that are still queued and
+ * then waits for them.
+ */
+DetectionWorkerPool::~DetectionWorkerPool()
+{
+    tasks.close();
+
+    for (int i = 0; i < workers.size(); i++) {
+        workers[i].join();
+        delete detectors[i];
+    }
+}
+
+/**
+ * Hands a frame to the next free worker. The frame must not be written to
+ * until the result is available.
+ *
+ * @param  frame        to analyze.
+ * @param  searchRegion the part of the frame to search, an empty Rect means the whole frame.
+ * @return              a future that holds the ObjectBox once the frame was analyzed.
+ */
+std::future<ObjectBox *> DetectionWorkerPool::submit(cv::Mat frame, cv::Rect searchRegion)
+{
+    Task task;
+    task.frame        = frame;
+    task.searchRegion = searchRegion;
+    std::future<ObjectBox *> result = task.result.get_future();
+
+    tasks.push(std::move(task));
+
+    return result;
+}
+
+/**
+ * Returns the number of worker threads.
+ *
+ * @return number of workers
+ */
+int DetectionWorkerPool::getNumberOfWorkers()
+{
+    return workers.size();
+}
+
+/**
+ * Invalidates the guidance of every worker's ObjectDetector, see
+ * ObjectDetector::invalidateGuidance().
+ */
+void DetectionWorkerPool::invalidateGuidance()
+{
+    for (int i = 0; i < detectors.size(); i++) detectors[i]->invalidateGuidance();
+}
+
+// MARK: PRIVATE
+
+/**
+ * This loop runs on every worker thread. Only this worker analyzes frames with
+ * its ObjectDetector.
+ *
+ * @param detector the ObjectDetector of the worker.
+ */
+void DetectionWorkerPool::workerLoop(ObjectDetector * detector)
+{
+    Task task;
+
+    while (tasks.pop(task)) {
+        try {
+            task.result.set_value(detector->processFrameUsingSURFandFLANN(task.frame, task.searchRegion));
+        }
+        catch (...) {
+            task.result.set_exception(std::current_exception());
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/*! \class DetectionWorkerPool DetectionWorkerPool.hpp "DetectionWorkerPool.hpp"
+**
+** The DetectionWorkerPool analyzes frames on a fixed number of worker threads.
+** Every worker owns its own ObjectDetector, so detectors, matchers and scratch
+** buffers are never shared between threads. The pool only reaches into them
+** to invalidate their guidance when the camera moved. Only the read-only TargetModel is
+** shared. This allows all the sample frames of one perception step to be
+** analyzed on all cores at once.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef DETECTIONWORKERPOOL_HPP
+#define DETECTIONWORKERPOOL_HPP
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <future>
+#include "opencv2/core/core.hpp"
+
+#include "BoundedQueue.hpp"
+#include "ObjectDetector.hpp"
+#include "TargetModel.hpp"
+#include "Logger.hpp"
+
+class ObjectBox;
+
+class DetectionWorkerPool {
+
+public:
+
+    DetectionWorkerPool(TargetModel * targetModel, DetectorSettings settings, int numberOfWorkers, SceneCache * sceneCache = NULL);
+    ~DetectionWorkerPool();
+    std::future<ObjectBox *> submit(cv::Mat frame, cv::Rect searchRegion = cv::Rect());
+    int getNumberOfWorkers();
+    void invalidateGuidance();
+
+private:
+
+    struct Task {
+        cv::Mat  frame;
+        cv::Rect searchRegion;
+        std::promise<ObjectBox *> result;
+    };
+
+    TargetModel *            targetModel;
+    DetectorSettings         settings;
+    SceneCache *             sceneCache;
+    BoundedQueue<Task>       tasks;
+    std::vector<std::thread> workers;
+    std::vector<ObjectDetector *> detectors;
+
+    void workerLoop(ObjectDetector * detector);
+};
+
+#endif //DETECTIONWORKERPOOL_HPP
@@ -69,6 +69,25 @@ struct PropertyNotFoundException : public Exception
     }
 };
 
+/**
+ * This exception is thrown when a property from the properties file has a value that is not supported.
+ */
+struct InvalidPropertyException : public Exception
+{
+    InvalidPropertyException(std::string property, std::string value) {
+        this->path = property;
+        name = "InvalidPropertyException";
+        text = name + ": Property " + property + " has an invalid value: " + value;
+    }
+
+    std::string message() const throw () {
+        return text;
+    }
+
+    private:
+        std::string text;
+};
+
 /**
  * This exception is thrown when a device that should be connected is not found while starting the program. These devices can be The Camera, the Launcher or the Arduino.
  */
@@ -94,6 +113,59 @@ struct DeviceNotFoundException : public Exception
         std::string text;
 };
 
+/**
+ * This exception is thrown when a frame recording can not be written or read, e.g. because it is not a recording or it is damaged.
+ */
+struct RecordingException : public Exception
+{
+    RecordingException(std::string path, std::string reason) {
+        this->path = path;
+        name = "RecordingException";
+        text = name + ": " + reason + ": " + path;
+    }
+
+    std::string message() const throw () {
+        return text;
+    }
+
+    private:
+        std::string text;
+};
+
+/**
+ * This exception is thrown when a vocabulary tree can not be built or read.
+ */
+struct VocabularyException : public Exception
+{
+    VocabularyException(std::string path, std::string reason) {
+        this->path = path;
+        name = "VocabularyException";
+        text = name + ": " + reason + ": " + path;
+    }
+
+    std::string message() const throw () {
+        return text;
+    }
+
+    private:
+        std::string text;
+};
+
+/**
+ * This exception is thrown when the last frame of a replayed recording was read.
+ */
+struct EndOfRecordingException : public Exception
+{
+    EndOfRecordingException(std::string path) {
+        this->path = path;
+        name = "EndOfRecordingException";
+    }
+
+    std::string message() const throw () {
+        return name + ": End of recording reached: " + path;
+    }
+};
+
 /**
  * This exception is thrown when the launcher cannot be claimed while the program is being set up.
  */
@@ -0,0 +1,336 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "FeatureBackend.hpp"
+
+/**
+ * Translates the name of a backend from the properties file into a backendType.
+ *
+ * @param  name the name of the backend.
+ * @return      the backendType
+ */
+FeatureSettings::backendType FeatureSettings::backendTypeWithName(std::string name)
+{
+    if (name == "surf")  return backendType::surf;
+    if (name == "orb")   return backendType::orb;
+    if (name == "brisk") return backendType::brisk;
+
+    throw InvalidPropertyException("vp_feature_backend", name);
+}
+
+/**
+ * The constructor creates the OpenCV detector of the selected backend.
+ *
+ * @param settings the feature settings.
+ */
+FeatureBackend::FeatureBackend(FeatureSettings settings)
+{
+    Logger::debug("FeatureBackend Constructor");
+    this->settings        = settings;
+    hessianThreshold      = settings.minHessian;
+    maxKeypoints          = 0;
+    detectedKeypointCount = 0;
+
+    switch (settings.backend) {
+        case FeatureSettings::surf  : feature2D = new cv::SURF(settings.minHessian, 4, 2, true, settings.surfUpright); break;
+        case FeatureSettings::orb   : feature2D = new cv::ORB(settings.orbFeatures);      break;
+        case FeatureSettings::brisk : feature2D = new cv::BRISK(settings.briskThreshold); break;
+    }
+}
+
+/**
+ * Detects the keypoints of a grayscale image and calculates their descriptors.
+ * Keypoints no descriptor can be calculated for are removed. If the settings
+ * ask for it, both happen in a single pass that shares the integral image or
+ * image pyramid, otherwise detect() and compute() are called one after the other.
+ * With tiled detection the image is analyzed in tiles on several threads.
+ *
+ * @param image       the grayscale image.
+ * @param keypoints   is set to the keypoints.
+ * @param descriptors is set to the descriptors, row i describes keypoint i.
+ */
+void FeatureBackend::detectAndCompute(const cv::Mat & image, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors)
+{
+    int tiles = tileCount(image);
+
+    if (tiles > 1) {
+        detectAndComputeTiled(image, tiles, keypoints, descriptors);
+        detectedKeypointCount = keypoints.size();
+        retainStrongest(keypoints, descriptors);
+        return;
+    }
+
+    if (settings.fusedDetectAndCompute) {
+        (*feature2D)(image, cv::noArray(), keypoints, descriptors);
+        detectedKeypointCount = keypoints.size();
+        retainStrongest(keypoints, descriptors);
+        return;
+    }
+
+    detect(image, keypoints);
+    compute(image, keypoints, descriptors);
+}
+
+/**
+ * Only detects the keypoints of an image. If there are more than
+ * maxKeypoints, only the strongest ones are kept.
+ *
+ * @param image     the grayscale image.
+ * @param keypoints is set to the detected keypoints.
+ */
+void FeatureBackend::detect(const cv::Mat & image, std::vector<cv::KeyPoint> & keypoints)
+{
+    feature2D->detect(image, keypoints);
+    detectedKeypointCount = keypoints.size();
+
+    if (maxKeypoints > 0 && keypoints.size() > maxKeypoints) cv::KeyPointsFilter::retainBest(keypoints, maxKeypoints);
+}
+
+/**
+ * Only calculates the descriptors of keypoints that were detected before.
+ * Keypoints a descriptor can not be calculated for are removed.
+ *
+ * @param image       the grayscale image the keypoints were detected in.
+ * @param keypoints   the keypoints.
+ * @param descriptors is set to one descriptor per keypoint.
+ */
+void FeatureBackend::compute(const cv::Mat & image, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors)
+{
+    feature2D->compute(image, keypoints, descriptors);
+}
+
+/**
+ * Returns whether the descriptors are binary (CV_8U, compared by Hamming
+ * distance) or float (CV_32F, compared by L2 distance).
+ *
+ * @return true for orb and brisk.
+ */
+bool FeatureBackend::binaryDescriptors()
+{
+    return settings.backend != FeatureSettings::surf;
+}
+
+/**
+ * Returns whether detectAndCompute() runs detection and description in a
+ * single pass.
+ *
+ * @return the fused detect and compute setting.
+ */
+bool FeatureBackend::fusedDetectAndCompute()
+{
+    return settings.fusedDetectAndCompute;
+}
+
+/**
+ * Returns whether detectAndCompute() splits the images into tiles. Only surf
+ * can do that.
+ *
+ * @return the tiled detection setting.
+ */
+bool FeatureBackend::tiledDetection()
+{
+    return settings.backend == FeatureSettings::surf && settings.detectionTiles > 1;
+}
+
+/**
+ * Returns the name of the backend together with every setting that changes the
+ * keypoints or descriptors. It is part of the key of the TargetCache.
+ *
+ * @return the description
+ */
+std::string FeatureBackend::description()
+{
+    switch (settings.backend) {
+        case FeatureSettings::surf  : return "surf "  + std::to_string(settings.minHessian) + (settings.surfUpright ? " upright" : "");
+        case FeatureSettings::orb   : return "orb "   + std::to_string(settings.orbFeatures);
+        case FeatureSettings::brisk : return "brisk " + std::to_string(settings.briskThreshold);
+    }
+    return "unknown";
+}
+
+/**
+ * Changes the surf hessian threshold the next images are analyzed with. The
+ * other backends do not have one and ignore it.
+ *
+ * @param threshold the hessian threshold.
+ */
+void FeatureBackend::setHessianThreshold(double threshold)
+{
+    if (settings.backend != FeatureSettings::surf || threshold == hessianThreshold) return;
+
+    feature2D->set("hessianThreshold", threshold);
+    hessianThreshold = threshold;
+}
+
+/**
+ * Returns the surf hessian threshold the next image is analyzed with.
+ *
+ * @return the hessian threshold, 0 for the other backends.
+ */
+double FeatureBackend::getHessianThreshold()
+{
+    return settings.backend == FeatureSettings::surf ? hessianThreshold : 0;
+}
+
+/**
+ * Limits the keypoints of an image to the strongest ones.
+ *
+ * @param maxKeypoints the most keypoints that are kept, 0 keeps all of them.
+ */
+void FeatureBackend::setMaxKeypoints(int maxKeypoints)
+{
+    this->maxKeypoints = maxKeypoints;
+}
+
+/**
+ * Returns how many keypoints were detected in the last image, before they
+ * were limited to maxKeypoints.
+ *
+ * @return the number of detected keypoints.
+ */
+int FeatureBackend::getDetectedKeypointCount()
+{
+    return detectedKeypointCount;
+}
+
+// MARK: PRIVATE
+
+/**
+ * Keeps the maxKeypoints keypoints with the highest response and their
+ * descriptors. Their order stays the same.
+ *
+ * @param keypoints   the keypoints.
+ * @param descriptors the descriptors, row i describes keypoint i.
+ */
+void FeatureBackend::retainStrongest(std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors)
+{
+    if (maxKeypoints <= 0 || keypoints.size() <= maxKeypoints) return;
+
+    std::vector<int> order(keypoints.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::nth_element(order.begin(), order.begin() + maxKeypoints, order.end(),
+                     [&keypoints](int a, int b) { return keypoints[a].response > keypoints[b].response; });
+    order.resize(maxKeypoints);
+    std::sort(order.begin(), order.end());
+
+    std::vector<cv::KeyPoint> strongestKeypoints(maxKeypoints);
+    cv::Mat                   strongestDescriptors(maxKeypoints, descriptors.cols, descriptors.type());
+
+    for (int i = 0; i < maxKeypoints; i++) {
+        strongestKeypoints[i] = keypoints[order[i]];
+        descriptors.row(order[i]).copyTo(strongestDescriptors.row(i));
+    }
+
+    keypoints   = strongestKeypoints;
+    descriptors = strongestDescriptors;
+}
+
+/**
+ * Returns into how many tiles an image is split. Every tile has to be at least
+ * as high as its overlap, otherwise it is not worth its own thread.
+ *
+ * @param  image the image.
+ * @return       the number of tiles, 1 if the image is analyzed as a whole.
+ */
+int FeatureBackend::tileCount(const cv::Mat & image)
+{
+    if (!tiledDetection()) return 1;
+
+    return std::max(1, std::min(settings.detectionTiles, image.rows / std::max(settings.tileOverlap, DETECTION_TILE_ALIGNMENT)));
+}
+
+/**
+ * Analyzes the tiles of an image on their own threads, the first one on the
+ * calling thread, and merges their keypoints and descriptors in the order of
+ * the tiles.
+ *
+ * @param image       the grayscale image.
+ * @param tiles       the number of tiles.
+ * @param keypoints   is set to the keypoints.
+ * @param descriptors is set to the descriptors, row i describes keypoint i.
+ */
+void FeatureBackend::detectAndComputeTiled(const cv::Mat & image, int tiles, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors)
+{
+    std::vector< std::vector<cv::KeyPoint> > tileKeypoints(tiles);
+    std::vector<cv::Mat>                     tileDescriptors(tiles);
+    std::vector<std::exception_ptr>          tileErrors(tiles);
+    std::vector<std::thread>                 threads;
+
+    auto analyzeTile = [&](int t) {
+        int top    = (image.rows * t / tiles)       / DETECTION_TILE_ALIGNMENT * DETECTION_TILE_ALIGNMENT;
+        int bottom = (image.rows * (t + 1) / tiles) / DETECTION_TILE_ALIGNMENT * DETECTION_TILE_ALIGNMENT;
+        if (t == tiles - 1) bottom = image.rows;
+
+        try {
+            detectAndComputeTile(image, cv::Range(top, bottom), tileKeypoints[t], tileDescriptors[t]);
+        }
+        catch (...) {
+            tileErrors[t] = std::current_exception();
+        }
+    };
+
+    for (int t = 1; t < tiles; t++) threads.push_back(std::thread(analyzeTile, t));
+    analyzeTile(0);
+    for (int t = 0; t < threads.size(); t++) threads[t].join();
+
+    for (int t = 0; t < tiles; t++) {
+        if (tileErrors[t]) std::rethrow_exception(tileErrors[t]);
+    }
+
+    keypoints   = std::vector<cv::KeyPoint>{};
+    descriptors = cv::Mat();
+
+    for (int t = 0; t < tiles; t++) {
+        if (tileKeypoints[t].empty()) continue;
+        keypoints.insert(keypoints.end(), tileKeypoints[t].begin(), tileKeypoints[t].end());
+        descriptors.push_back(tileDescriptors[t]);
+    }
+}
+
+/**
+ * Detects the keypoints of the rows of one tile and calculates their
+ * descriptors. The tile is detected with the overlap above and below it, but
+ * only the keypoints in its own rows are kept. The descriptors are calculated
+ * on the tile as well, with a margin that holds the descriptor window of every
+ * keypoint. Usually that is the overlap, so the rows of the detection are used
+ * again.
+ *
+ * @param image       the whole grayscale image.
+ * @param rows        the rows of the tile.
+ * @param keypoints   is set to the keypoints of the tile in image coordinates.
+ * @param descriptors is set to their descriptors.
+ */
+void FeatureBackend::detectAndComputeTile(const cv::Mat & image, cv::Range rows, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors)
+{
+    int overlap = (settings.tileOverlap + DETECTION_TILE_ALIGNMENT - 1) / DETECTION_TILE_ALIGNMENT * DETECTION_TILE_ALIGNMENT;
+    int top     = std::max(0, rows.start - overlap);
+    int bottom  = std::min(image.rows, rows.end + overlap);
+
+    std::vector<cv::KeyPoint> detectedKeypoints;
+    feature2D->detect(image.rowRange(top, bottom), detectedKeypoints);
+
+    keypoints = std::vector<cv::KeyPoint>{};
+
+    for (int i = 0; i < detectedKeypoints.size(); i++) {
+        cv::KeyPoint keypoint = detectedKeypoints[i];
+        keypoint.pt.y += top;
+        if (keypoint.pt.y >= rows.start && keypoint.pt.y < rows.end) keypoints.push_back(keypoint);
+    }
+
+    if (keypoints.empty()) {
+        descriptors = cv::Mat();
+        return;
+    }
+
+    float largestSize = 0;
+    for (int i = 0; i < keypoints.size(); i++) largestSize = std::max(largestSize, keypoints[i].size);
+
+    int margin = std::max(overlap, (int) std::ceil(SURF_DESCRIPTOR_RADIUS * largestSize));
+    top        = std::max(0, rows.start - margin);
+    bottom     = std::min(image.rows, rows.end + margin);
+
+    for (int i = 0; i < keypoints.size(); i++) keypoints[i].pt.y -= top;
+    feature2D->compute(image.rowRange(top, bottom), keypoints, descriptors);
+    for (int i = 0; i < keypoints.size(); i++) keypoints[i].pt.y += top;
+}
@@ -0,0 +1,115 @@
+/*! \class FeatureBackend FeatureBackend.hpp "FeatureBackend.hpp"
+**
+** The FeatureBackend detects keypoints and calculates their descriptors. The
+** target and every frame have to be analyzed by the same kind of backend,
+** otherwise their descriptors can not be compared. There are three backends:
+**
+** -surf calculates float descriptors that are compared by their L2 distance.
+** It is the most robust one but also by far the slowest.
+**
+** -orb and brisk calculate binary descriptors that are compared by their
+** Hamming distance, i.e. the number of bits that differ. They are several
+** times faster than surf.
+**
+** Upright surf skips the orientation of the keypoints. The descriptors are
+** not rotation invariant anymore, which does not matter because the target
+** is always upright, and they are a lot faster to calculate.
+**
+** The scene backends can change the surf hessian threshold from frame to frame
+** (see KeypointBudget) and keep only the strongest keypoints of a frame.
+**
+** detectAndCompute() can run both steps in a single pass. The integral image
+** (surf) or the image pyramid (orb, brisk) is then only built once instead of
+** once for detect() and once more for compute(). The results are the same.
+**
+** surf can also split the image into horizontal tiles that are analyzed on
+** several threads at once. Every tile is detected with a margin of overlap
+** rows above and below, and only keeps the keypoints in its own rows, so there
+** are no duplicates. The tiles start at multiples of DETECTION_TILE_ALIGNMENT,
+** where the sample grid of every surf octave starts as well. With an overlap
+** of at least half the largest surf filter, the tiles find exactly the same
+** keypoints as the whole image. The descriptors are calculated on the tile as
+** well, but with a margin that is large enough for the descriptor window of
+** its largest keypoint, so they are the same as on the whole image too.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef FEATUREBACKEND_HPP
+#define FEATUREBACKEND_HPP
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include "opencv2/core/core.hpp"
+#include "opencv2/features2d/features2d.hpp"
+#include <opencv2/nonfree/features2d.hpp>
+
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+/** The rows every tile starts at are a multiple of this, the sample step of the coarsest surf octave. */
+#define DETECTION_TILE_ALIGNMENT 8
+/** The descriptor window of a surf keypoint reaches at most this many times its size from its center. */
+#define SURF_DESCRIPTOR_RADIUS 2.0f
+
+/**
+ * The settings of all backends. Only the ones of the selected backend are used.
+ */
+struct FeatureSettings
+{
+    enum backendType {
+        surf,
+        orb,
+        brisk
+    };
+
+    backendType backend;
+    int         minHessian;
+    bool        surfUpright;
+    int         orbFeatures;
+    int         briskThreshold;
+    bool        fusedDetectAndCompute;
+    int         detectionTiles; // surf only, 1 analyzes the image as a whole.
+    int         tileOverlap;
+
+    static backendType backendTypeWithName(std::string name);
+};
+
+class FeatureBackend {
+
+public:
+
+    FeatureBackend(FeatureSettings settings);
+    void detectAndCompute(const cv::Mat & image, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors);
+    void detect(const cv::Mat & image, std::vector<cv::KeyPoint> & keypoints);
+    void compute(const cv::Mat & image, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors);
+
+    bool        binaryDescriptors();
+    bool        fusedDetectAndCompute();
+    bool        tiledDetection();
+    std::string description();
+
+    void        setHessianThreshold(double threshold);
+    double      getHessianThreshold();
+    void        setMaxKeypoints(int maxKeypoints);
+    int         getDetectedKeypointCount();
+
+private:
+
+    FeatureSettings        settings;
+    cv::Ptr<cv::Feature2D> feature2D;
+    double                 hessianThreshold;
+    int                    maxKeypoints, detectedKeypointCount;
+
+    void retainStrongest(std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors);
+    int  tileCount(const cv::Mat & image);
+    void detectAndComputeTiled(const cv::Mat & image, int tiles, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors);
+    void detectAndComputeTile(const cv::Mat & image, cv::Range rows, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors);
+};
+
+#endif //FEATUREBACKEND_HPP
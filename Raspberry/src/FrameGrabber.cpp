@@ -0,0 +1,140 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "FrameGrabber.hpp"
+
+/**
+ * The constructor only stores the capture device. The capture thread is not
+ * started until start() is called.
+ *
+ * @param capture the FrameSource to read from.
+ */
+FrameGrabber::FrameGrabber(FrameSource * capture)
+{
+    Logger::debug("FrameGrabber Constructor");
+    this->capture = capture;
+    running       = false;
+    frameCount    = 0;
+}
+
+/**
+ * The destructor makes sure the capture thread is not left running.
+ */
+FrameGrabber::~FrameGrabber()
+{
+    stop();
+}
+
+/**
+ * Starts the background thread that keeps reading frames from the camera.
+ */
+void FrameGrabber::start()
+{
+    std::lock_guard<std::mutex> lock(slotMutex);
+    if (running) return;
+
+    running = true;
+    captureThread = std::thread(&FrameGrabber::captureLoop, this);
+}
+
+/**
+ * Stops the background thread and waits for it to finish its last read.
+ */
+void FrameGrabber::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(slotMutex);
+        running = false;
+    }
+    frameAvailable.notify_all();
+
+    if (captureThread.joinable()) captureThread.join();
+}
+
+/**
+ * Returns the first frame whose capture was started after the specified time.
+ * If the newest frame in the slot is too old this function blocks until the
+ * capture thread publishes a newer one. The returned cv::Mat is never written
+ * to by the FrameGrabber again, so it is safe to keep and draw onto it.
+ *
+ * @param  time        frames captured before or at this time are rejected.
+ * @param  captureTime is set to the capture time of the returned frame if not NULL.
+ * @return             the frame.
+ */
+cv::Mat FrameGrabber::getFrameCapturedAfter(timePoint time, timePoint * captureTime)
+{
+    std::unique_lock<std::mutex> lock(slotMutex);
+
+    bool received = frameAvailable.wait_until(lock,
+        std::max(time, std::chrono::steady_clock::now()) + std::chrono::milliseconds(FRAME_GRABBER_TIMEOUT),
+        [&] { return !running || (!latestFrame.empty() && latestFrameTime > time); });
+
+    if (captureError) std::rethrow_exception(captureError);
+
+    if (!received || !running) {
+        throw DeviceNotFoundException("Webcam stopped delivering frames");
+    }
+
+    if (captureTime != NULL) *captureTime = latestFrameTime;
+
+    return latestFrame;
+}
+
+/**
+ * Returns the number of frames that were read from the camera so far.
+ *
+ * @return frame count
+ */
+long FrameGrabber::getFrameCount()
+{
+    std::lock_guard<std::mutex> lock(slotMutex);
+    return frameCount;
+}
+
+// MARK: PRIVATE
+
+/**
+ * This loop runs on the capture thread. It reads every frame the camera
+ * delivers and replaces the content of the slot with it. The timestamp is taken
+ * before the read so that a frame that is stamped after a time T was exposed
+ * after T for sure.
+ */
+void FrameGrabber::captureLoop()
+{
+    while (true) {
+
+        timePoint start = std::chrono::steady_clock::now();
+
+        // a new cv::Mat every time so frames that were handed out stay untouched.
+        cv::Mat newFrame;
+        bool success = false;
+
+        try {
+            success = capture->read(newFrame);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(slotMutex);
+            captureError = std::current_exception();
+            running      = false;
+            frameAvailable.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(slotMutex);
+            if (!running) return;
+
+            if (success && !newFrame.empty()) {
+                latestFrame     = newFrame;
+                latestFrameTime = start;
+                frameCount++;
+                frameAvailable.notify_all();
+                continue;
+            }
+        }
+
+        // the camera did not deliver a frame. Do not spin on it.
+        usleep(10000);
+    }
+}
@@ -0,0 +1,65 @@
+/*! \class FrameGrabber FrameGrabber.hpp "FrameGrabber.hpp"
+**
+** The FrameGrabber continuously reads frames from a FrameSource on a
+** background thread and only keeps the newest one. Every frame is stamped with
+** the time its capture was started. Consumers do not read from the camera
+** themselves but ask for the first frame that was captured after a certain
+** point in time. This way OpenCV's internal buffer never fills up and no
+** stale frames have to be thrown away.
+** If the FrameSource throws, e.g. because a replayed recording ended, the
+** exception is rethrown to the consumer.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef FRAMEGRABBER_HPP
+#define FRAMEGRABBER_HPP
+
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include "opencv2/opencv.hpp"
+#include "opencv2/highgui/highgui.hpp"
+
+#include "FrameSource.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+/** Time in milliseconds to wait for a frame before the camera is considered lost. */
+#define FRAME_GRABBER_TIMEOUT 3000
+
+class FrameGrabber {
+
+public:
+
+    typedef std::chrono::steady_clock::time_point timePoint;
+
+    FrameGrabber(FrameSource * capture);
+    ~FrameGrabber();
+    void    start();
+    void    stop();
+    cv::Mat getFrameCapturedAfter(timePoint time, timePoint * captureTime = NULL);
+    long    getFrameCount();
+
+private:
+
+    FrameSource *           capture;
+    std::exception_ptr      captureError;
+    std::thread             captureThread;
+    std::mutex              slotMutex;
+    std::condition_variable frameAvailable;
+    bool                    running;
+
+    // the single slot mailbox
+    cv::Mat   latestFrame;
+    timePoint latestFrameTime;
+    long      frameCount;
+
+    void captureLoop();
+};
+
+#endif //FRAMEGRABBER_HPP
@@ -0,0 +1,89 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "FrameQualityGate.hpp"
+
+/**
+ * Reads the sharpness threshold and the longest time to wait for a sharp
+ * frame from the properties.
+ */
+FrameQualityGate::FrameQualityGate()
+{
+    Logger::debug("FrameQualityGate Constructor");
+
+    Properties * properties = Properties::getInstance();
+    threshold      = properties->getFloatPropertyWithName("vp_sharpness_threshold");
+    scale          = properties->getFloatPropertyWithName("vp_sharpness_scale");
+    maxSettleDelay = properties->getNumberPropertyWithName("vp_max_settle_delay");
+    logging        = properties->getNumberPropertyWithName("frame_debugging_output") == 1;
+    moving         = false;
+}
+
+/**
+ * Tells the gate that the camera just moved, so the next frames have to be
+ * checked for blur.
+ */
+void FrameQualityGate::motionCommanded()
+{
+    moving     = true;
+    motionTime = std::chrono::steady_clock::now();
+}
+
+/**
+ * Returns whether the gate is still waiting for the first sharp frame after
+ * the last motion.
+ *
+ * @return true if frames are checked for blur.
+ */
+bool FrameQualityGate::settling()
+{
+    return moving;
+}
+
+/**
+ * Decides whether a frame can be analyzed. While the camera is settling the
+ * frame has to be sharp enough, or maxSettleDelay has to be over.
+ *
+ * @param  frame the frame from the camera.
+ * @return       true if the frame is accepted.
+ */
+bool FrameQualityGate::accept(const cv::Mat & frame)
+{
+    if (!moving) return true;
+
+    double score  = sharpness(frame);
+    long   waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - motionTime).count();
+    bool   sharp  = score >= threshold;
+
+    if (logging) {
+        printf("Sharpness: %8.1f after %4ld ms -> %s\n", score, waited, sharp ? "sharp" : (waited >= maxSettleDelay ? "timeout" : "skipped"));
+    }
+
+    if (!sharp && waited < maxSettleDelay) return false;
+
+    moving = false;
+    return true;
+}
+
+/**
+ * Scores the sharpness of a frame as the variance of its Laplacian. The frame
+ * is downsampled first, which is a lot faster and still shows motion blur.
+ *
+ * @param  frame the frame to score.
+ * @return       the sharpness, the higher the sharper.
+ */
+double FrameQualityGate::sharpness(const cv::Mat & frame)
+{
+    cv::resize(frame, smallFrame, cv::Size(), scale, scale, cv::INTER_AREA);
+
+    if (smallFrame.channels() == 3) cv::cvtColor(smallFrame, grayFrame, CV_BGR2GRAY);
+    else                            grayFrame = smallFrame;
+
+    cv::Laplacian(grayFrame, laplacian, CV_64F);
+
+    cv::Scalar mean, deviation;
+    cv::meanStdDev(laplacian, mean, deviation);
+
+    return deviation[0] * deviation[0];
+}
@@ -0,0 +1,45 @@
+/*! \class FrameQualityGate FrameQualityGate.hpp "FrameQualityGate.hpp"
+**
+** The FrameQualityGate decides whether a frame is sharp enough to be analyzed.
+** After the vehicle or the launcher moved, the camera image is blurry until
+** the robot stands still again. Instead of always waiting a fixed time, the
+** gate scores the sharpness of each frame (the variance of the Laplacian on a
+** downsampled gray image) and accepts the first one that is sharp enough.
+** If no frame gets sharp enough, e.g. because the scene has little texture,
+** the first frame after maxSettleDelay is accepted anyway.
+** As long as the robot did not move, every frame is accepted without scoring.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef FRAMEQUALITYGATE_HPP
+#define FRAMEQUALITYGATE_HPP
+
+#include <stdio.h>
+#include <chrono>
+#include "opencv2/core/core.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include "Properties.hpp"
+#include "Logger.hpp"
+
+class FrameQualityGate {
+
+public:
+
+    FrameQualityGate();
+    void   motionCommanded();
+    bool   settling();
+    bool   accept(const cv::Mat & frame);
+    double sharpness(const cv::Mat & frame);
+
+private:
+
+    float threshold, scale;
+    int   maxSettleDelay;
+    bool  logging, moving;
+    std::chrono::steady_clock::time_point motionTime;
+    cv::Mat smallFrame, grayFrame, laplacian;
+};
+
+#endif //FRAMEQUALITYGATE_HPP
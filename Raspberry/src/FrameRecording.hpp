@@ -0,0 +1,49 @@
+/*!
+** The FrameRecording.hpp file defines the file format of frame recordings that
+** are written by the RecordingFrameSource and read by the ReplayFrameSource.
+**
+** A recording starts with a FrameRecordingHeader. Every frame follows as a
+** FrameRecordingEntry and the encoded image (JPEG or PNG) right after it. When
+** the recording is closed properly, the entries of all frames are written once
+** more as an index at the end and the header points to it, so a frame can be
+** found without reading the frames before it. If the program ends without
+** closing the recording, the index is missing and the reader walks through
+** the entries instead.
+** All numbers are stored in the byte order of the machine that recorded them.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef FRAMERECORDING_HPP
+#define FRAMERECORDING_HPP
+
+#include <stdint.h>
+
+/** The first bytes of every recording. */
+#define FRAME_RECORDING_MAGIC "MMLFRAME"
+/** The version of the file format. */
+#define FRAME_RECORDING_VERSION 1
+
+/**
+ * The header at the start of a recording.
+ */
+struct FrameRecordingHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t frameCount;  // 0 if the recording was not closed properly.
+    uint64_t indexOffset; // 0 if the recording was not closed properly.
+};
+
+/**
+ * Describes one frame of a recording.
+ */
+struct FrameRecordingEntry
+{
+    int64_t  captureTime; // microseconds since the first frame was captured.
+    uint64_t offset;      // where the encoded image starts.
+    uint32_t size;        // the size of the encoded image in bytes.
+    uint32_t reserved;
+};
+
+#endif //FRAMERECORDING_HPP
@@ -0,0 +1,60 @@
+/*! \class FrameSource FrameSource.hpp "FrameSource.hpp"
+**
+** A FrameSource delivers the frames the VideoProcessor analyzes. Usually this
+** is the camera (CameraFrameSource), but the frames can also be recorded while
+** they are read (RecordingFrameSource) or come from such a recording
+** (ReplayFrameSource). This way the perception can run on a machine without a
+** camera and the same frames can be analyzed again and again.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef FRAMESOURCE_HPP
+#define FRAMESOURCE_HPP
+
+#include <string>
+#include "opencv2/core/core.hpp"
+
+#include "Exceptions.hpp"
+
+class FrameSource {
+
+public:
+
+    enum sourceType {camera, record, replay};
+
+    virtual ~FrameSource() {};
+
+    /**
+     * Reads the next frame.
+     *
+     * @param  frame is set to the frame.
+     * @return false if no frame could be read right now.
+     */
+    virtual bool read(cv::Mat & frame) = 0;
+
+    /**
+     * Returns whether the frames come from a camera in real time. Only then
+     * OpenCV's buffer has to be skipped.
+     *
+     * @return true for a live camera.
+     */
+    virtual bool live() = 0;
+
+    /**
+     * Translates the name of a source into its sourceType.
+     *
+     * @param  name the value of vp_frame_source.
+     * @return      the source type.
+     */
+    static sourceType sourceTypeWithName(std::string name)
+    {
+        if (name == "camera") return sourceType::camera;
+        if (name == "record") return sourceType::record;
+        if (name == "replay") return sourceType::replay;
+
+        throw InvalidPropertyException("vp_frame_source", name);
+    }
+};
+
+#endif //FRAMESOURCE_HPP
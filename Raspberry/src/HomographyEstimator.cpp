@@ -0,0 +1,317 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "HomographyEstimator.hpp"
+
+/**
+ * Returns twice the signed area of the triangle a, b, c. It is positive if the
+ * corners are ordered counterclockwise and close to 0 if they are on a line.
+ */
+static double signedArea(cv::Point2f a, cv::Point2f b, cv::Point2f c)
+{
+    return (double) (b.x - a.x) * (c.y - a.y) - (double) (b.y - a.y) * (c.x - a.x);
+}
+
+/**
+ * Creates an estimator. The random samples are drawn by a generator with a
+ * fixed seed, so the same matches always give the same result.
+ *
+ * @param type              the model that is fitted.
+ * @param reprojectionError the most pixels a match may be off the model to count as an inlier.
+ */
+HomographyEstimator::HomographyEstimator(modelType type, double reprojectionError)
+    : rng(0x4d4d4c)
+{
+    Logger::debug("HomographyEstimator Constructor");
+    this->type              = type;
+    this->reprojectionError = reprojectionError;
+}
+
+/**
+ * Fits the homography that maps the target points onto the scene points.
+ *
+ * @param  targetPoints the target points of the matches.
+ * @param  scenePoints  the scene points of the matches.
+ * @param  distances    the descriptor distances of the matches, the lower the
+ *                      better. If there are none, the matches are used in their order.
+ * @param  inlierMask   is set to 1 for every match that fits the homography.
+ * @return              the homography with its inliers and residual. H is empty
+ *                      if there were too few matches or no model was found.
+ */
+HomographyFit HomographyEstimator::estimate(const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                                            const std::vector<float> & distances, std::vector<uchar> & inlierMask)
+{
+    HomographyFit fit = {cv::Mat(), 0, 0, 0};
+    inlierMask = std::vector<uchar>(targetPoints.size(), 0);
+
+    int count = std::min(targetPoints.size(), scenePoints.size());
+    if (count < (type == homography || type == ransac ? 4 : 3)) return fit;
+
+    if (type == ransac) {
+        fit.H = cv::findHomography(targetPoints, scenePoints, CV_RANSAC, reprojectionError);
+        if (!fit.H.empty()) fit.inliers = countInliers(fit.H, targetPoints, scenePoints, inlierMask, fit.residual);
+        return fit;
+    }
+
+    // PROSAC draws from the best matches first.
+    order.resize(count);
+    std::iota(order.begin(), order.end(), 0);
+    if (distances.size() >= count) {
+        std::stable_sort(order.begin(), order.end(), [&distances](int a, int b) { return distances[a] < distances[b]; });
+    }
+
+    if (type != homography) {
+        fit = sample(true, targetPoints, scenePoints, inlierMask);
+
+        if (type == affine) {
+            refine(true, targetPoints, scenePoints, fit, inlierMask);
+            return fit;
+        }
+        if (fit.inliers >= ESTIMATOR_MIN_AFFINE_INLIERS) {
+            refine(false, targetPoints, scenePoints, fit, inlierMask);
+            return fit;
+        }
+        if (count < 4) return fit;
+    }
+
+    int affineIterations = fit.iterations;
+
+    fit = sample(false, targetPoints, scenePoints, inlierMask);
+    fit.iterations += affineIterations;
+    refine(false, targetPoints, scenePoints, fit, inlierMask);
+    return fit;
+}
+
+/**
+ * Counts the matches that fit a homography.
+ *
+ * @param  H            the homography.
+ * @param  targetPoints the target points of the matches.
+ * @param  scenePoints  the scene points of the matches.
+ * @param  inlierMask   is set to 1 for every match that fits.
+ * @param  residual     is set to the mean reprojection error of the inliers.
+ * @return              the number of inliers.
+ */
+int HomographyEstimator::countInliers(const cv::Mat & H, const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                                      std::vector<uchar> & inlierMask, double & residual)
+{
+    cv::perspectiveTransform(targetPoints, projectedPoints, H);
+
+    int    inliers    = 0;
+    double errorTotal = 0;
+    inlierMask = std::vector<uchar>(targetPoints.size(), 0);
+
+    for (int i = 0; i < projectedPoints.size() && i < scenePoints.size(); i++) {
+        double error = cv::norm(projectedPoints[i] - scenePoints[i]);
+        if (error <= reprojectionError) {
+            inlierMask[i] = 1;
+            inliers++;
+            errorTotal += error;
+        }
+    }
+
+    residual = inliers > 0 ? errorTotal / inliers : 0;
+    return inliers;
+}
+
+/**
+ * Translates the name of a model from the properties file into a modelType.
+ *
+ * @param  name the name of the model.
+ * @return      the modelType
+ */
+HomographyEstimator::modelType HomographyEstimator::modelTypeWithName(std::string name)
+{
+    if (name == "homography") return modelType::homography;
+    if (name == "affine")     return modelType::affine;
+    if (name == "auto")       return modelType::automatic;
+    if (name == "ransac")     return modelType::ransac;
+
+    throw InvalidPropertyException("vp_homography_model", name);
+}
+
+// MARK: PRIVATE
+
+/**
+ * Draws samples in PROSAC order and keeps the model with the most inliers.
+ * The samples start with the best matches and the set they are drawn from
+ * grows by one match whenever as many samples were drawn as RANSAC would draw
+ * from a set of that size. Every sample contains the match that was added
+ * last, until it is time for the next one.
+ * Sampling stops as soon as a model with only inliers would have been drawn
+ * with ESTIMATOR_CONFIDENCE, given the inlier ratio of the best model so far.
+ *
+ * @param  affineModel  whether affine models from 3 points or homographies from 4 are fitted.
+ * @param  targetPoints the target points of the matches.
+ * @param  scenePoints  the scene points of the matches.
+ * @param  inlierMask   is set to the inliers of the best model.
+ * @return              the best model.
+ */
+HomographyFit HomographyEstimator::sample(bool affineModel, const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                                          std::vector<uchar> & inlierMask)
+{
+    HomographyFit best = {cv::Mat(), 0, 0, 0};
+
+    int sampleSize = affineModel ? 3 : 4;
+    int count      = order.size();
+    if (count < sampleSize) return best;
+
+    // T_n: the samples RANSAC would draw from the best n matches.
+    double samplesFromSubset = ESTIMATOR_MAX_ITERATIONS;
+    for (int i = 0; i < sampleSize; i++) samplesFromSubset *= (double) (sampleSize - i) / (count - i);
+
+    int    subset        = sampleSize;
+    double growthSample  = 1;
+    int    maxIterations = ESTIMATOR_MAX_ITERATIONS;
+    int    indices[4];
+
+    std::vector<uchar> mask;
+    cv::Mat            H;
+
+    for (int t = 1; t <= maxIterations; t++) {
+
+        if (t > growthSample && subset < count) {
+            double samplesFromNextSubset = samplesFromSubset * (subset + 1) / (subset + 1 - sampleSize);
+            growthSample     += std::ceil(samplesFromNextSubset - samplesFromSubset);
+            samplesFromSubset = samplesFromNextSubset;
+            subset++;
+        }
+
+        // Until the subset grows again, every sample contains its newest match.
+        int drawn = 0, range = subset;
+        if (t <= growthSample) {
+            indices[drawn++] = order[subset - 1];
+            range--;
+        }
+        while (drawn < sampleSize) {
+            int index = order[rng.uniform(0, range)];
+            bool duplicate = false;
+            for (int i = 0; i < drawn; i++) duplicate = duplicate || indices[i] == index;
+            if (!duplicate) indices[drawn++] = index;
+        }
+
+        best.iterations = t;
+        if (!fitSample(affineModel, targetPoints, scenePoints, indices, H)) continue;
+
+        double residual;
+        int    inliers = countInliers(H, targetPoints, scenePoints, mask, residual);
+
+        if (inliers > best.inliers || (inliers == best.inliers && inliers > 0 && residual < best.residual)) {
+            best.H        = H.clone();
+            best.inliers  = inliers;
+            best.residual = residual;
+            inlierMask    = mask;
+
+            double allInliers = std::pow((double) inliers / count, sampleSize);
+            if (allInliers >= 1) break;
+            double needed = std::log(1 - ESTIMATOR_CONFIDENCE) / std::log(1 - allInliers);
+            maxIterations = std::min((double) ESTIMATOR_MAX_ITERATIONS, std::ceil(needed));
+        }
+    }
+
+    return best;
+}
+
+/**
+ * Fits a model to a sample. Samples with three points on a line can not be
+ * fitted. A homography sample whose points are mirrored in the scene is
+ * skipped as well, because the target can not be seen from behind.
+ *
+ * @param  affineModel  whether an affine model from 3 points or a homography from 4 is fitted.
+ * @param  targetPoints the target points of the matches.
+ * @param  scenePoints  the scene points of the matches.
+ * @param  indices      the matches of the sample.
+ * @param  H            is set to the model as a 3x3 homography.
+ * @return              whether a model could be fitted.
+ */
+bool HomographyEstimator::fitSample(bool affineModel, const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                                    const int * indices, cv::Mat & H)
+{
+    cv::Point2f target[4], scene[4];
+    int sampleSize = affineModel ? 3 : 4;
+
+    for (int i = 0; i < sampleSize; i++) {
+        target[i] = targetPoints[indices[i]];
+        scene[i]  = scenePoints[indices[i]];
+    }
+
+    static const int triangles[4][3] = {{0, 1, 2}, {0, 1, 3}, {0, 2, 3}, {1, 2, 3}};
+
+    for (int i = 0; i < (affineModel ? 1 : 4); i++) {
+        const int * c = triangles[i];
+        double targetArea = signedArea(target[c[0]], target[c[1]], target[c[2]]);
+        double sceneArea  = signedArea(scene[c[0]],  scene[c[1]],  scene[c[2]]);
+
+        if (std::abs(targetArea) < 1 || std::abs(sceneArea) < 1) return false;
+        if ((targetArea > 0) != (sceneArea > 0)) return false;
+    }
+
+    if (affineModel) {
+        H = cv::Mat::eye(3, 3, CV_64F);
+        cv::getAffineTransform(target, scene).copyTo(H.rowRange(0, 2));
+    } else {
+        H = cv::getPerspectiveTransform(target, scene);
+    }
+
+    return true;
+}
+
+/**
+ * Fits the model to all inliers of the best sample by least squares. The
+ * refined model is only used if it keeps at least as many inliers.
+ *
+ * @param affineModel  whether an affine model or a homography is fitted.
+ * @param targetPoints the target points of the matches.
+ * @param scenePoints  the scene points of the matches.
+ * @param fit          the best model, it is replaced by the refined one.
+ * @param inlierMask   the inliers of the best model, they are updated with it.
+ */
+void HomographyEstimator::refine(bool affineModel, const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                                 HomographyFit & fit, std::vector<uchar> & inlierMask)
+{
+    if (fit.H.empty() || fit.inliers < (affineModel ? 3 : 4)) return;
+
+    std::vector<cv::Point2f> inlierTargets, inlierScenes;
+    for (int i = 0; i < inlierMask.size(); i++) {
+        if (!inlierMask[i]) continue;
+        inlierTargets.push_back(targetPoints[i]);
+        inlierScenes.push_back(scenePoints[i]);
+    }
+
+    cv::Mat H;
+
+    if (affineModel) {
+        cv::Mat A(2 * inlierTargets.size(), 6, CV_64F, cv::Scalar(0)), b(2 * inlierTargets.size(), 1, CV_64F), x;
+
+        for (int i = 0; i < inlierTargets.size(); i++) {
+            A.at<double>(2 * i,     0) = inlierTargets[i].x;
+            A.at<double>(2 * i,     1) = inlierTargets[i].y;
+            A.at<double>(2 * i,     2) = 1;
+            A.at<double>(2 * i + 1, 3) = inlierTargets[i].x;
+            A.at<double>(2 * i + 1, 4) = inlierTargets[i].y;
+            A.at<double>(2 * i + 1, 5) = 1;
+            b.at<double>(2 * i,     0) = inlierScenes[i].x;
+            b.at<double>(2 * i + 1, 0) = inlierScenes[i].y;
+        }
+
+        if (!cv::solve(A, b, x, cv::DECOMP_SVD)) return;
+
+        H = cv::Mat::eye(3, 3, CV_64F);
+        for (int i = 0; i < 6; i++) H.at<double>(i / 3, i % 3) = x.at<double>(i, 0);
+    } else {
+        H = cv::findHomography(inlierTargets, inlierScenes, 0);
+        if (H.empty()) return;
+    }
+
+    std::vector<uchar> mask;
+    double residual;
+    int    inliers = countInliers(H, targetPoints, scenePoints, mask, residual);
+
+    if (inliers < fit.inliers) return;
+
+    fit.H        = H;
+    fit.inliers  = inliers;
+    fit.residual = residual;
+    inlierMask   = mask;
+}
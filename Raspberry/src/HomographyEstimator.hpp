@@ -0,0 +1,100 @@
+/*! \class HomographyEstimator HomographyEstimator.hpp "HomographyEstimator.hpp"
+**
+** The HomographyEstimator fits the homography that maps the target points of
+** the matches onto their scene points and tells which matches fit it. Like
+** RANSAC it fits models to small random samples and keeps the one most
+** matches agree with, but it is cheaper in three ways:
+**
+** -PROSAC: the matches are sorted by their descriptor distance and the
+** samples are first drawn from the best ones only. The set they are drawn
+** from grows step by step until it contains all matches. Good matches are
+** more likely to be inliers, so a good model is found a lot sooner.
+**
+** -Early termination: after every better model the number of samples that
+** are needed to find a model with only inliers with ESTIMATOR_CONFIDENCE is
+** updated. If most matches are inliers, a few dozen samples are enough.
+**
+** -Affine fast path: the target hardly ever is seen at an angle, so an affine
+** model from 3 points is a good approximation. With the automatic model the
+** inliers are searched with affine samples, which need far fewer samples than
+** homographies from 4 points, and the homography is then fitted to them. Only
+** if the affine samples do not find enough inliers the homography samples are
+** drawn as well.
+**
+** With fewer matches than the model needs, nothing is fitted at all.
+** Finally the model is refined by least squares on all of its inliers.
+** The ransac model skips all of this and calls cv::findHomography() with
+** RANSAC, like the detector did before, so the others can be compared with it.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef HOMOGRAPHYESTIMATOR_HPP
+#define HOMOGRAPHYESTIMATOR_HPP
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "opencv2/core/core.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+#include "opencv2/calib3d/calib3d.hpp"
+
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+/** The probability that the best model was found when sampling stops. */
+#define ESTIMATOR_CONFIDENCE 0.995
+/** The most samples that are drawn for one model. */
+#define ESTIMATOR_MAX_ITERATIONS 2000
+/** The fewest inliers the affine samples have to find to skip the homography samples. */
+#define ESTIMATOR_MIN_AFFINE_INLIERS 8
+
+/**
+ * The result of an estimation.
+ */
+struct HomographyFit
+{
+    cv::Mat H;          // 3x3 CV_64F, empty if no model was found.
+    int     inliers;
+    double  residual;   // mean reprojection error of the inliers in pixels.
+    int     iterations; // number of samples that were drawn.
+};
+
+class HomographyEstimator {
+
+public:
+
+    enum modelType {
+        homography,
+        affine,
+        automatic,
+        ransac
+    };
+
+    HomographyEstimator(modelType type, double reprojectionError);
+    HomographyFit estimate(const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                           const std::vector<float> & distances, std::vector<uchar> & inlierMask);
+    int           countInliers(const cv::Mat & H, const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                               std::vector<uchar> & inlierMask, double & residual);
+
+    static modelType modelTypeWithName(std::string name);
+
+private:
+
+    modelType        type;
+    double           reprojectionError;
+    cv::RNG          rng;
+    std::vector<int> order;
+    std::vector<cv::Point2f> projectedPoints;
+
+    HomographyFit sample(bool affineModel, const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                         std::vector<uchar> & inlierMask);
+    bool          fitSample(bool affineModel, const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                            const int * indices, cv::Mat & H);
+    void          refine(bool affineModel, const std::vector<cv::Point2f> & targetPoints, const std::vector<cv::Point2f> & scenePoints,
+                         HomographyFit & fit, std::vector<uchar> & inlierMask);
+};
+
+#endif //HOMOGRAPHYESTIMATOR_HPP
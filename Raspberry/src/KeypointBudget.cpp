@@ -0,0 +1,63 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "KeypointBudget.hpp"
+
+/**
+ * Creates a keypoint budget.
+ *
+ * @param keypointTarget   the keypoints wanted per frame, 0 keeps the threshold fixed.
+ * @param minThreshold     the lowest threshold that may be used.
+ * @param maxThreshold     the highest threshold that may be used.
+ * @param initialThreshold the threshold of the first frame.
+ */
+KeypointBudget::KeypointBudget(int keypointTarget, double minThreshold, double maxThreshold, double initialThreshold)
+{
+    Logger::debug("KeypointBudget Constructor");
+    this->keypointTarget = keypointTarget;
+    this->minThreshold   = minThreshold;
+    this->maxThreshold   = std::max(minThreshold, maxThreshold);
+    threshold            = initialThreshold;
+
+    if (enabled()) threshold = std::max(this->minThreshold, std::min(threshold, this->maxThreshold));
+}
+
+/**
+ * Returns whether the threshold is adapted at all.
+ *
+ * @return true if there is a keypoint target.
+ */
+bool KeypointBudget::enabled()
+{
+    return keypointTarget > 0;
+}
+
+/**
+ * Returns the threshold the next frame is to be analyzed with.
+ *
+ * @return the hessian threshold.
+ */
+double KeypointBudget::getThreshold()
+{
+    return threshold;
+}
+
+/**
+ * Adapts the threshold to the number of keypoints the last frame yielded.
+ * A frame without any keypoints counts as one, so the threshold still drops
+ * by the largest step.
+ *
+ * @param keypointCount the keypoints that were detected with getThreshold().
+ * @param regionShare   the share of the frame that was searched (0 - 1).
+ */
+void KeypointBudget::update(int keypointCount, double regionShare)
+{
+    if (!enabled()) return;
+
+    double wanted = std::max(1.0, keypointTarget * regionShare);
+    double step   = std::pow(std::max(1, keypointCount) / wanted, KEYPOINT_BUDGET_GAIN);
+
+    step      = std::max(1.0 / KEYPOINT_BUDGET_MAX_STEP, std::min(step, KEYPOINT_BUDGET_MAX_STEP));
+    threshold = std::max(minThreshold, std::min(threshold * step, maxThreshold));
+}
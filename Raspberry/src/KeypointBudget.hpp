@@ -0,0 +1,48 @@
+/*! \class KeypointBudget KeypointBudget.hpp "KeypointBudget.hpp"
+**
+** The KeypointBudget adapts the SURF hessian threshold from frame to frame, so
+** that every frame yields about the same number of keypoints. With a fixed
+** threshold a cluttered scene produces thousands of keypoints and a blank wall
+** almost none, and the time matching and RANSAC take varies just as much.
+**
+** The number of keypoints roughly falls with a power of the threshold, so the
+** threshold is multiplied by the ratio of detected to wanted keypoints raised
+** to KEYPOINT_BUDGET_GAIN. A gain below 1 lets it settle within a few frames
+** without oscillating. The step of a single frame and the threshold itself
+** are limited, so one odd frame can not throw it off.
+** The budget is for the whole frame. If only a search region is analyzed, the
+** wanted keypoints shrink with its area, so the keypoint density stays the same.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef KEYPOINTBUDGET_HPP
+#define KEYPOINTBUDGET_HPP
+
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+#include "Logger.hpp"
+
+/** How strongly the threshold follows the keypoint error. */
+#define KEYPOINT_BUDGET_GAIN 0.7
+/** The largest factor the threshold changes by from one frame to the next. */
+#define KEYPOINT_BUDGET_MAX_STEP 2.0
+
+class KeypointBudget {
+
+public:
+
+    KeypointBudget(int keypointTarget, double minThreshold, double maxThreshold, double initialThreshold);
+    bool   enabled();
+    double getThreshold();
+    void   update(int keypointCount, double regionShare);
+
+private:
+
+    int    keypointTarget;
+    double minThreshold, maxThreshold, threshold;
+};
+
+#endif //KEYPOINTBUDGET_HPP
@@ -31,6 +31,7 @@ const char * LauncherController::commandHex[] = {
 LauncherController::LauncherController()
 {
     Logger::debug("Launcher Constructor");
+    moved = false;
     this->init();
 }
 
@@ -71,6 +72,8 @@ void LauncherController::executeCommand(enum launcherCommand command)
     unsigned char buf[65535];
     const char * tempCommand = commandHex[(int) command];
 
+    if (command != stop) moved = true;
+
     std::memcpy(buf, tempCommand, 0x8);
     libusb_control_transfer(launcher, LIBUSB_REQUEST_TYPE_CLASS +  LIBUSB_RECIPIENT_INTERFACE, 0x9, 0x200, 0x0, buf, 0x8, 1000);
 
@@ -101,3 +104,15 @@ void LauncherController::executeCommand(launcherCommand command, int time)
     usleep(time * 1000);
     executeCommand(launcherCommand::stop);
 }
+
+/**
+ * Returns whether the launcher moved (or fired) since the last call. The
+ * commands can come from another thread, so the flag is read and reset at
+ * once.
+ *
+ * @return true if the launcher moved.
+ */
+bool LauncherController::movedSinceLastCheck()
+{
+    return moved.exchange(false);
+}
@@ -3,6 +3,7 @@
 ** This class defines functions to controll the launcher. It does this by writing
 ** codes to the serial USB connection that the launcher is connected to. The launcher
 ** listens to these codes and starts executing the desired action.
+** It also remembers whether the launcher moved, because that moves the camera.
 **
 ** @author Daniel Palenicek
 ** @version 1.0 / 26.08.2015
@@ -18,6 +19,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <atomic>
 #include <libusb-1.0/libusb.h>
 
 #include "Exceptions.hpp"
@@ -53,12 +55,14 @@ public:
     LauncherController();
     void executeCommand(enum launcherCommand command);
     void executeCommand(enum launcherCommand command, int time);
+    bool movedSinceLastCheck();
 
 private:
     libusb_context * context;
     libusb_device * device;
     libusb_device_handle * launcher;
     static const char * commandHex[];
+    std::atomic<bool> moved;
 
     void init(void);
 };
@@ -0,0 +1,216 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "MultiTargetDetector.hpp"
+#include "ObjectBox.hpp"
+
+/**
+ * The constructor sets up the detector with the configured settings. The
+ * frames are analyzed with the FeatureSettings of the library. The hessian
+ * threshold is adapted by a KeypointBudget just like in the ObjectDetector.
+ *
+ * @param library        the targets to look for. They are shared and not modified.
+ * @param settings       the detector settings.
+ * @param vocabulary     the vocabulary the library was built from or NULL to match against all targets.
+ * @param candidateCount the number of shortlisted targets that are matched per frame.
+ */
+MultiTargetDetector::MultiTargetDetector(TargetLibrary * library, DetectorSettings settings, VocabularyTree * vocabulary, int candidateCount)
+    : features(library->getFeatureSettings()),
+      keypointBudget(library->getFeatureSettings().backend == FeatureSettings::surf ? settings.keypointTarget : 0,
+                     settings.minHessian, settings.maxHessian, library->getFeatureSettings().minHessian),
+      estimator(settings.homographyModel, HOMOGRAPHY_REPROJECTION_ERROR)
+{
+    Logger::debug("MultiTargetDetector Constructor");
+    this->library      = library;
+    this->settings       = settings;
+    this->vocabulary     = vocabulary;
+    this->candidateCount = candidateCount;
+    combinedIndexReady   = false;
+
+    features.setMaxKeypoints(settings.maxKeypoints);
+}
+
+/**
+ * Describes the frame once, matches it against all targets and locates every
+ * target in it.
+ *
+ * @param  currentFrame the frame to be processed.
+ * @return              one new ObjectBox per target, in the order of the library.
+ */
+std::vector<ObjectBox *> MultiTargetDetector::processFrame(cv::Mat currentFrame)
+{
+    std::vector<ObjectBox *> objectBoxes;
+
+    try {
+        if (vocabulary == NULL) library->setUp();
+
+        features.setHessianThreshold(keypointBudget.getThreshold());
+
+        cv::cvtColor(currentFrame, sceneFrame, CV_BGRA2GRAY);
+        if( !sceneFrame.data )   throw FileNotFoundException(" --(!) Error reading frame ");
+
+        features.detectAndCompute(sceneFrame, sceneKeypoints, sceneDescriptors);
+        keypointBudget.update(features.getDetectedKeypointCount(), 1.0);
+
+        if (vocabulary == NULL) matchAllTargets();
+        else                    matchCandidates();
+
+        for (int t = 0; t < library->targetCount(); t++) {
+            objectBoxes.push_back(locateTarget(t));
+
+            if (settings.frameDebuggingOutput && !targetMatches[t].empty()) {
+                printf("Target %d: %4zu matches, confidence %4.2f\n", t, targetMatches[t].size(), objectBoxes[t]->getConfidence());
+            }
+        }
+        return objectBoxes;
+    }
+    catch (Exception &e) {
+        std::cout << "Exception analyizing frame.\n" << e.what() << std::endl;
+    }
+    catch (cv::Exception &e) {
+        std::cout << "OpenCV exception analyizing frame.\n" << e.what() << std::endl;
+    }
+
+    for (int t = 0; t < objectBoxes.size(); t++) delete objectBoxes[t];
+    objectBoxes = std::vector<ObjectBox *>{};
+
+    std::array<cv::Point2f, 4> cornerPoints = {cv::Point2f(0,0), cv::Point2f(0,0), cv::Point2f(0,0), cv::Point2f(0,0)};
+    for (int t = 0; t < library->targetCount(); t++) objectBoxes.push_back(new ObjectBox(cornerPoints, 0));
+    return objectBoxes;
+}
+
+// MARK: PRIVATE
+
+/**
+ * Looks up the two closest combined descriptors of every scene descriptor and
+ * keeps the distinct ones.
+ */
+void MultiTargetDetector::matchAllTargets()
+{
+    targetMatches.assign(library->targetCount(), std::vector<cv::DMatch>{});
+
+    const cv::Mat & combinedDescriptors = library->getCombinedDescriptors();
+    if (sceneDescriptors.empty() || combinedDescriptors.rows < 2) return;
+
+    if (settings.matcherType == TargetMatcher::bruteForce) {
+        bruteForceMatcher.findTwoNearest(sceneDescriptors, combinedDescriptors, indices, distances);
+    } else {
+        if (!combinedIndexReady) {
+            library->loadCombinedIndex(combinedIndex);
+            combinedIndexReady = true;
+        }
+        combinedIndex.knnSearch(sceneDescriptors, indices, distances, 2, cv::flann::SearchParams(32));
+    }
+
+    keepDistinctMatches(library->getEntryTargets(), library->getEntryKeypoints());
+}
+
+/**
+ * Shortlists the targets that are most similar to the frame by the vocabulary
+ * and matches the frame only against their descriptors. The candidates are
+ * set up here the first time they are shortlisted.
+ */
+void MultiTargetDetector::matchCandidates()
+{
+    targetMatches.assign(library->targetCount(), std::vector<cv::DMatch>{});
+
+    vocabulary->shortlist(sceneDescriptors, candidateCount, candidates);
+
+    candidateDescriptors    = cv::Mat();
+    candidateEntryTargets   = std::vector<int>{};
+    candidateEntryKeypoints = std::vector<int>{};
+
+    for (int c = 0; c < candidates.size(); c++) {
+        TargetModel * targetModel = library->getTarget(candidates[c].target);
+        targetModel->setUpSURFandFLANN();
+
+        const cv::Mat & targetDescriptors = targetModel->getObjectDescriptors();
+        if (targetDescriptors.empty()) continue;
+
+        candidateDescriptors.push_back(targetDescriptors);
+        for (int k = 0; k < targetDescriptors.rows; k++) {
+            candidateEntryTargets.push_back(candidates[c].target);
+            candidateEntryKeypoints.push_back(k);
+        }
+
+        if (settings.frameDebuggingOutput) printf("Candidate %d: score %5.3f\n", candidates[c].target, candidates[c].score);
+    }
+
+    if (sceneDescriptors.empty() || candidateDescriptors.rows < 2) return;
+
+    bruteForceMatcher.findTwoNearest(sceneDescriptors, candidateDescriptors, indices, distances);
+    keepDistinctMatches(candidateEntryTargets, candidateEntryKeypoints);
+}
+
+/**
+ * Applies Lowe's ratio test to the two closest entries of every scene
+ * descriptor. A good match is added to the matches of the target its closest
+ * entry belongs to, with the keypoint of that target as queryIdx and the scene
+ * keypoint as trainIdx.
+ *
+ * @param entryTargets   the target every entry belongs to.
+ * @param entryKeypoints the keypoint every entry describes within its target.
+ */
+void MultiTargetDetector::keepDistinctMatches(const std::vector<int> & entryTargets, const std::vector<int> & entryKeypoints)
+{
+    // FLANN returns Hamming distances as integers, L2 distances are squared.
+    if (distances.type() != CV_32F) distances.convertTo(distances, CV_32F);
+
+    bool  binary        = library->binaryDescriptors();
+    float distanceRatio = binary ? settings.ratio : settings.ratio * settings.ratio;
+
+    for (int i = 0; i < sceneDescriptors.rows; i++) {
+
+        int entry = indices.at<int>(i, 0);
+        if (entry < 0 || indices.at<int>(i, 1) < 0) continue;
+
+        float closest = distances.at<float>(i, 0), secondClosest = distances.at<float>(i, 1);
+        if (!(closest < distanceRatio * secondClosest)) continue;
+
+        targetMatches[entryTargets[entry]].push_back(
+            cv::DMatch(entryKeypoints[entry], i, binary ? closest : std::sqrt(closest)));
+    }
+}
+
+/**
+ * Fits the homography of a target to its matches and maps the corners of the
+ * target image into the frame.
+ *
+ * @param  target the index of the target.
+ * @return        a new ObjectBox with the corners and the confidence of the
+ *                detection. Without a homography all corners are 0.
+ */
+ObjectBox * MultiTargetDetector::locateTarget(int target)
+{
+    TargetModel *                     targetModel     = library->getTarget(target);
+    const std::vector<cv::KeyPoint> & targetKeypoints = targetModel->getTargetKeypoints();
+    const std::vector<cv::DMatch> &   matches         = targetMatches[target];
+
+    targetVector   = std::vector<cv::Point2f>{};
+    sceneVector    = std::vector<cv::Point2f>{};
+    matchDistances = std::vector<float>{};
+
+    for (int i = 0; i < matches.size(); i++) {
+        targetVector.push_back(targetKeypoints[matches[i].queryIdx].pt);
+        sceneVector.push_back(sceneKeypoints[matches[i].trainIdx].pt);
+        matchDistances.push_back(matches[i].distance);
+    }
+
+    HomographyFit fit = estimator.estimate(targetVector, sceneVector, matchDistances, inlierMask);
+
+    std::array<cv::Point2f, 4> cornerPoints = {cv::Point2f(0,0), cv::Point2f(0,0), cv::Point2f(0,0), cv::Point2f(0,0)};
+    if (fit.H.empty()) return new ObjectBox(cornerPoints, 0);
+
+    const cv::Mat & targetImage = targetModel->getTargetImage();
+    std::vector<cv::Point2f> targetCorners(4), sceneCorners(4);
+    targetCorners[0] = cv::Point2f(               0,                0);
+    targetCorners[1] = cv::Point2f(targetImage.cols,                0);
+    targetCorners[2] = cv::Point2f(targetImage.cols, targetImage.rows);
+    targetCorners[3] = cv::Point2f(               0, targetImage.rows);
+
+    cv::perspectiveTransform(targetCorners, sceneCorners, fit.H);
+    cornerPoints = {sceneCorners[0], sceneCorners[1], sceneCorners[2], sceneCorners[3]};
+
+    return new ObjectBox(cornerPoints, ObjectDetector::detectionConfidence(fit.inliers, matches.size(), fit.residual));
+}
@@ -0,0 +1,87 @@
+/*! \class MultiTargetDetector MultiTargetDetector.hpp "MultiTargetDetector.hpp"
+**
+** The MultiTargetDetector looks for all targets of a TargetLibrary in a frame
+** and returns one ObjectBox per target. The frame is described only once and
+** every scene descriptor is looked up once in the combined index of the
+** library (or compared with all combined descriptors by the brute force
+** matcher). The closest entry tells which target and which keypoint of it the
+** scene keypoint matches. So the matching costs grow with the number of scene
+** keypoints, not with the number of targets. Only the homographies are fitted
+** per target, and only to the matches of that target.
+** The ratio test compares the two closest entries of all targets. A scene
+** keypoint that looks like keypoints of two different targets is ambiguous
+** and is not used for either of them.
+** flannScene matching needs an index per frame and target, so the combined
+** index over the targets is used instead. Guided matching, the scene cache and
+** search regions are only supported by the single target ObjectDetector.
+** With a VocabularyTree the frame is not matched against all targets. The
+** vocabulary shortlists the few targets whose visual words are most similar
+** to the ones of the frame and only their descriptors are compared with the
+** brute force matcher. Their homographies are fitted, every other target gets
+** an empty ObjectBox. So the costs per frame hardly grow with the size of the
+** library and its targets are only set up once they are shortlisted.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef MULTITARGETDETECTOR_HPP
+#define MULTITARGETDETECTOR_HPP
+
+#include <iostream>
+#include <array>
+#include <cmath>
+#include <vector>
+#include "opencv2/core/core.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+#include "opencv2/features2d/features2d.hpp"
+#include "opencv2/flann/flann.hpp"
+
+#include "TargetLibrary.hpp"
+#include "VocabularyTree.hpp"
+#include "ObjectDetector.hpp"
+#include "FeatureBackend.hpp"
+#include "BruteForceMatcher.hpp"
+#include "HomographyEstimator.hpp"
+#include "KeypointBudget.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+class ObjectBox;
+
+class MultiTargetDetector {
+
+public:
+
+    MultiTargetDetector(TargetLibrary * library, DetectorSettings settings, VocabularyTree * vocabulary = NULL, int candidateCount = 0);
+    std::vector<ObjectBox *> processFrame(cv::Mat currentFrame);
+
+private:
+
+    TargetLibrary *    library;
+    VocabularyTree *   vocabulary;
+    int                candidateCount;
+    DetectorSettings   settings;
+    FeatureBackend     features;
+    KeypointBudget     keypointBudget;
+    HomographyEstimator estimator;
+    BruteForceMatcher  bruteForceMatcher;
+    cv::flann::Index   combinedIndex;
+    bool               combinedIndexReady;
+
+    cv::Mat                   sceneFrame, sceneDescriptors, indices, distances;
+    std::vector<cv::KeyPoint> sceneKeypoints;
+    std::vector< std::vector<cv::DMatch> > targetMatches;
+    std::vector<cv::Point2f>  targetVector, sceneVector;
+    std::vector<float>        matchDistances;
+    std::vector<uchar>        inlierMask;
+    std::vector<VocabularyCandidate> candidates;
+    cv::Mat                   candidateDescriptors;
+    std::vector<int>          candidateEntryTargets, candidateEntryKeypoints;
+
+    void        matchAllTargets();
+    void        matchCandidates();
+    void        keepDistinctMatches(const std::vector<int> & entryTargets, const std::vector<int> & entryKeypoints);
+    ObjectBox * locateTarget(int target);
+};
+
+#endif //MULTITARGETDETECTOR_HPP
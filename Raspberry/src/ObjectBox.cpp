@@ -7,8 +7,9 @@
 
 #include "ObjectBox.hpp"
 
-int  ObjectBox::boxCounter = 0;
-bool ObjectBox::debug      = false;
+std::atomic<int> ObjectBox::boxCounter(0);
+bool             ObjectBox::debug = false;
+float            ObjectBox::minConfidence = 0;
 
 // MARK: Constructors
 
@@ -18,6 +19,7 @@ bool ObjectBox::debug      = false;
  * from different frames from the camera that are combined to one ObjectBox.
  * This approach wants to make the object detection more accurate by minimizing
  * the imact of mistakes that were made during the object recognition.
+ * The corners are the mean of the relevant samples, weighted by their confidence.
  */
 ObjectBox::ObjectBox(std::vector<ObjectBox> sampleObjectBoxes)
 {
@@ -30,7 +32,7 @@ ObjectBox::ObjectBox(std::vector<ObjectBox> sampleObjectBoxes)
     cv::Point2f c = cv::Point2f(0,0);
     cv::Point2f d = cv::Point2f(0,0);
 
-    float relevantBoxes = 0;
+    float confidenceSum = 0;
 
     for (int i=0; i<sampleObjectBoxes.size(); i++) {
 
@@ -39,21 +41,24 @@ ObjectBox::ObjectBox(std::vector<ObjectBox> sampleObjectBoxes)
         // if is relevant Box. i.e. object was detected and it is a plausible box.
         if (sampleObjectBoxes[i].isRelevant()) {
 
-            relevantBoxes += 1;
-            a += temp[0];
-            b += temp[1];
-            c += temp[2];
-            d += temp[3];
+            float weight   = sampleObjectBoxes[i].getConfidence();
+            confidenceSum += weight;
+            a += temp[0] * weight;
+            b += temp[1] * weight;
+            c += temp[2] * weight;
+            d += temp[3] * weight;
         }
 
         sampleObjectBoxes[i].printObjectBox();
     }
 
-    if (relevantBoxes > 0) {
-        a = cv::Point2f(a.x/relevantBoxes, a.y/relevantBoxes);
-        b = cv::Point2f(b.x/relevantBoxes, b.y/relevantBoxes);
-        c = cv::Point2f(c.x/relevantBoxes, c.y/relevantBoxes);
-        d = cv::Point2f(d.x/relevantBoxes, d.y/relevantBoxes);
+    if (confidenceSum > 0) {
+        a = cv::Point2f(a.x/confidenceSum, a.y/confidenceSum);
+        b = cv::Point2f(b.x/confidenceSum, b.y/confidenceSum);
+        c = cv::Point2f(c.x/confidenceSum, c.y/confidenceSum);
+        d = cv::Point2f(d.x/confidenceSum, d.y/confidenceSum);
+        // Samples that missed the target count with a confidence of 0.
+        confidence = confidenceSum / sampleObjectBoxes.size();
     }
 
     this->a = a;
@@ -70,14 +75,18 @@ ObjectBox::ObjectBox(std::vector<ObjectBox> sampleObjectBoxes)
 /**
  * This constructor just makes a simple ObjectBox object using the object's four
  * corner points that the video frame analysis found.
+ *
+ * @param objectCornerPoints the corners a, b, c and d.
+ * @param confidence         how much the corners can be trusted, 1 for a full detection.
  */
-ObjectBox::ObjectBox(std::array<cv::Point2f, 4> objectCornerPoints)
+ObjectBox::ObjectBox(std::array<cv::Point2f, 4> objectCornerPoints, float confidence)
 {
     Logger::debug("ObjectBox Constructor 2");
     a = objectCornerPoints[0];
     b = objectCornerPoints[1];
     c = objectCornerPoints[2];
     d = objectCornerPoints[3];
+    this->confidence = confidence;
 
 
     this->sample      = true;
@@ -116,6 +125,29 @@ bool ObjectBox::isSample() { return sample; }
  */
 bool ObjectBox::isRelevant() { return relevant; }
 
+/**
+ * Simple getter function for the confidence value. The confidence of a fused
+ * ObjectBox is the mean confidence of all its samples, where samples that are
+ * not relevant count as 0.
+ *
+ * @method ObjectBox::getConfidence
+ * @return confidence between 0 and 1
+ */
+float ObjectBox::getConfidence() { return confidence; }
+
+/**
+ * Returns whether the ObjectBox was taken from the SceneCache instead of
+ * being detected in its frame.
+ *
+ * @return true if it repeats an earlier detection.
+ */
+bool ObjectBox::isCached() { return cached; }
+
+/**
+ * Marks the ObjectBox as taken from the SceneCache.
+ */
+void ObjectBox::markCached() { cached = true; }
+
 /**
  * Getter for the objectCenter
  *
@@ -215,6 +247,7 @@ cv::Point2f ObjectBox::distanceOfObjectToCameraCenter()
  * object from the ones that are just garbage. Since the VideoProcessors processNextFrame()
  * function always returns an ObjectBox object it is the filter() functions duty
  * to seperate the meaningful ObjectBoxes from the garbage.
+ * Samples whose confidence is below minConfidence are garbage as well.
  *
  * @method ObjectBox::filter
  * @return does the ObjectBox really represent the target obejct in the scene?
@@ -223,7 +256,7 @@ bool ObjectBox::filter()
 {
     bool result = true;
 
-    char area = '+', rot = '+', relH = '+', relV = '+';
+    char area = '+', rot = '+', relH = '+', relV = '+', conf = '+';
     // is the ObjectBoxes area big enough?
     if (!(getRelativeObjectArea() > 0.01)) {
       area = '-';
@@ -246,13 +279,32 @@ bool ObjectBox::filter()
       result = false;
     }
 
-    if (isSample() && debug) printf("  filter %4d area:%c rotation:%c rel_H:%c rel_V:%c\n", boxID, area, rot, relH, relV);
+    // Does the detection itself look trustworthy?
+    if (isSample() && confidence < minConfidence) {
+      conf = '-';
+      result = false;
+    }
+
+    if (isSample() && debug) printf("  filter %4d area:%c rotation:%c rel_H:%c rel_V:%c conf:%c\n", boxID, area, rot, relH, relV, conf);
     //printObjectBox();
 
     return result;
 }
 
 
+/**
+ * Sets the confidence a sample needs to pass the filter. With 0 the confidence
+ * only weights the samples when they are mixed.
+ *
+ * @method ObjectBox::setMinConfidence
+ * @param  minConfidence between 0 and 1.
+ */
+void ObjectBox::setMinConfidence(float minConfidence)
+{
+    ObjectBox::minConfidence = minConfidence;
+}
+
+
 // MARK: Drawing functions
 
 /**
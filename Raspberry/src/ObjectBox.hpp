@@ -12,6 +12,13 @@
 ** object detection by the VideoProcessor. This is acceived by throwing away
 ** samples that are obviously wrong and then mixing all the other plausible
 ** samples.
+** Every ObjectBox carries a confidence between 0 and 1. The ObjectDetector
+** rates every detection by its inliers and their reprojection error, boxes
+** that were tracked from an earlier frame lose confidence the more points were
+** lost on the way. Samples below the min confidence are not relevant,
+** the others are weighted by their confidence when they are mixed.
+** A box that was taken from the SceneCache is marked as cached. It repeats an
+** earlier detection and is no new evidence.
 **
 ** @author Daniel Palenicek
 ** @version 0.1 / 23.09.2016
@@ -23,6 +30,7 @@
 #define OBJECTBOX_HPP
 
 #include <string>
+#include <atomic>
 #include "opencv2/features2d/features2d.hpp"
 #include "VideoProcessor.hpp"
 #include "Logger.hpp"
@@ -34,12 +42,15 @@ public:
     // MARK: Constructors
     ObjectBox() {};
     ObjectBox(std::vector<ObjectBox> sampleObjectBoxes);
-    ObjectBox(std::array<cv::Point2f, 4> objectCornerPoints);
+    ObjectBox(std::array<cv::Point2f, 4> objectCornerPoints, float confidence = 1.0);
 
     // MARK: Getter
     std::array<cv::Point2f, 4> getObjectCornerPoints();
     bool        isSample();
     bool        isRelevant();
+    float       getConfidence();
+    bool        isCached();
+    void        markCached();
 
     // MARK: Object property calculations
     bool        objectDetected();
@@ -51,6 +62,7 @@ public:
 
     // MARK: Filters
     bool filter();
+    static void setMinConfidence(float minConfidence);
 
     // MARK: Drawing functions
     void drawBorders(cv::Mat &frame, cv::Point2f origin);
@@ -77,11 +89,14 @@ private:
     cv::Scalar  green = cv::Scalar(   0, 255,    0);
     cv::Scalar  red   = cv::Scalar(   0,    0, 255);
     float       screenArea;
+    float       confidence = 0;
+    bool        cached     = false;
 
     bool sample;
     bool relevant;
-    static int boxCounter;
+    static std::atomic<int> boxCounter;
     static bool debug;
+    static float minConfidence;
     int boxID;
 
     void init();
@@ -0,0 +1,442 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "ObjectDetector.hpp"
+#include "ObjectBox.hpp"
+
+/**
+ * The constructor sets up the detector with the configured settings. The
+ * frames are analyzed by the same kind of FeatureBackend as the target. The
+ * hessian threshold of the frames starts at the one of the target and is then
+ * adapted by the KeypointBudget. Only surf has a hessian threshold.
+ *
+ * @param targetModel the target to look for. It is shared and not modified.
+ * @param settings    the detector settings.
+ * @param sceneCache  the results of unchanged scenes are taken from it, can be NULL.
+ */
+ObjectDetector::ObjectDetector(TargetModel * targetModel, DetectorSettings settings, SceneCache * sceneCache)
+    : features(targetModel->getFeatureSettings()), matcher(targetModel, settings.matcherType, settings.ratio),
+      keypointBudget(targetModel->getFeatureSettings().backend == FeatureSettings::surf ? settings.keypointTarget : 0,
+                     settings.minHessian, settings.maxHessian, targetModel->getFeatureSettings().minHessian),
+      estimator(settings.homographyModel, HOMOGRAPHY_REPROJECTION_ERROR)
+{
+    Logger::debug("ObjectDetector Constructor");
+    this->targetModel   = targetModel;
+    this->settings      = settings;
+    this->sceneCache    = sceneCache;
+    stagesMeasured      = false;
+    guidanceValid       = false;
+    guidanceInvalidated = false;
+    stats               = DetectionStats{};
+
+    features.setMaxKeypoints(settings.maxKeypoints);
+}
+
+/**
+ * This function analyzes a frame using the surf and flann algorithm. It looks for the target, identifies it's corner points and returns an ObjectBox pointer.
+ * If a search region is specified, keypoints are only detected inside of it,
+ * which is a lot cheaper than searching the whole frame if the target is small.
+ * The corner points are still in the coordinates of the whole frame.
+ * If the SceneCache has the result of a frame that showed the same scene, that
+ * result is returned instead without analyzing the frame.
+ * If the target was found in the last frame, guided matching is tried first.
+ * The ObjectBox carries the confidence of the detection, see detectionConfidence().
+ *
+ * @param currentFrame the frame to be processed
+ * @param searchRegion the part of the frame to search, an empty Rect means the whole frame.
+ * @return              The object box pointer
+ */
+ObjectBox * ObjectDetector::processFrameUsingSURFandFLANN(cv::Mat currentFrame, cv::Rect searchRegion)
+{
+    inlierMask = std::vector<uchar>{};
+    if (guidanceInvalidated.exchange(false)) guidanceValid = false;
+
+    try {
+
+        targetModel->setUpSURFandFLANN();
+
+        const cv::Mat &                   targetImage     = targetModel->getTargetImage();
+        const std::vector<cv::KeyPoint> & targetKeypoints = targetModel->getTargetKeypoints();
+
+        cv::Rect frameRegion(0, 0, currentFrame.cols, currentFrame.rows);
+        searchRegion &= frameRegion;
+        if (searchRegion.area() <= 0) searchRegion = frameRegion;
+
+        long cacheGeneration = 0;
+        if (sceneCache != NULL) {
+            ObjectBox * cachedBox = sceneCache->lookup(currentFrame, searchRegion, sceneSignature, cacheGeneration);
+            if (cachedBox != NULL) return cachedBox;
+        }
+
+        features.setHessianThreshold(keypointBudget.getThreshold());
+        stats.hessianThreshold = features.getHessianThreshold();
+        stats.keypoints        = 0;
+
+        startStages();
+
+        cv::cvtColor(currentFrame(searchRegion), sceneFrame, CV_BGRA2GRAY); // currentFrame;
+        finishStage(DetectionStats::colorConversion);
+
+        if( !sceneFrame.data )   throw FileNotFoundException(" --(!) Error reading frame ");
+
+        // Detect the keypoints and calculate their descriptors (feature vectors)
+        if (features.fusedDetectAndCompute() || features.tiledDetection()) {
+            features.detectAndCompute( sceneFrame, sceneKeypoints, sceneDescriptors );
+            finishStage(DetectionStats::keypointDetection);
+        } else {
+            features.detect( sceneFrame, sceneKeypoints );
+            finishStage(DetectionStats::keypointDetection);
+            features.compute( sceneFrame, sceneKeypoints, sceneDescriptors );
+        }
+        finishStage(DetectionStats::descriptorExtraction);
+
+        stats.keypoints = features.getDetectedKeypointCount();
+        keypointBudget.update(stats.keypoints, (double) searchRegion.area() / frameRegion.area());
+
+        if (settings.frameDebuggingOutput) {
+            printf("Keypoints: %4d detected, %4zu used, hessian threshold %6.1f\n",
+                   stats.keypoints, sceneKeypoints.size(), stats.hessianThreshold);
+        }
+
+        stats.inliers    = 0;
+        stats.residual   = 0;
+        stats.iterations = 0;
+        stats.confidence = 0;
+
+        if (sceneDescriptors.empty())  std::cout << "sceneVector discriptor empty"  << std::endl;
+
+        cv::Point2f regionOrigin = searchRegion.tl();
+        stats.guided = settings.guidedMatching && guidanceValid && matchGuided(regionOrigin);
+
+        if (!stats.guided) {
+            matcher.findCandidates( sceneDescriptors );
+            finishStage(DetectionStats::matching);
+            matcher.filterCandidates( goodMatches );
+            finishStage(DetectionStats::matchFiltering);
+
+            // Localize the object
+            targetVector   = std::vector<cv::Point2f>{};
+            sceneVector = std::vector<cv::Point2f>{};
+
+            for( int i = 0; i < goodMatches.size(); i++ )
+            {
+              // Get the keypoints from the good matches
+              targetVector.push_back( targetKeypoints[ goodMatches[i].queryIdx ].pt );
+              sceneVector.push_back( sceneKeypoints[ goodMatches[i].trainIdx ].pt + regionOrigin );
+            }
+
+            estimateHomography( H );
+        }
+
+        // Get the corners from the image_1 ( the object to be "detected" )
+        std::vector<cv::Point2f> targetCorners(4);
+        targetCorners[0] = cvPoint(                0,                0 );
+        targetCorners[1] = cvPoint( targetImage.cols,                0 );
+        targetCorners[2] = cvPoint( targetImage.cols, targetImage.rows );
+        targetCorners[3] = cvPoint(                0, targetImage.rows );
+        std::vector<cv::Point2f> sceneCorners(4);
+
+        // Without a homography the target was not found.
+        if (!H.empty()) cv::perspectiveTransform( targetCorners, sceneCorners, H);
+        stats.confidence = H.empty() ? 0 : detectionConfidence(stats.inliers, goodMatches.size(), stats.residual);
+
+        // Draw lines between the corners (the mapped object in the sceneVector - image_2 )
+        cornerPoints = {sceneCorners[0], sceneCorners[1], sceneCorners[2],sceneCorners[3]};
+        finishStage(DetectionStats::homography);
+
+        if (settings.frameDebuggingOutput) {
+            printf("Homography: %4d of %4zu matches fit, residual %4.2f px, %4d samples, confidence %4.2f%s\n",
+                   stats.inliers, goodMatches.size(), stats.residual, stats.iterations, stats.confidence,
+                   stats.guided ? ", guided" : "");
+        }
+
+        ObjectBox * detectedBox = new ObjectBox(cornerPoints, stats.confidence);
+        finishStage(DetectionStats::objectBox);
+
+        guidanceValid = !H.empty() && detectedBox->objectDetected();
+
+        if (sceneCache != NULL) sceneCache->store(sceneSignature, searchRegion, cacheGeneration, detectedBox);
+
+        return detectedBox;
+    }
+    catch (Exception &e) {
+        std::cout << "Exception analyizing frame.\n" << e.what() << std::endl;
+    }
+    catch (cv::Exception &e) {
+        std::cout << "OpenCV exception analyizing frame.\n" << e.what() << std::endl;
+    }
+
+    guidanceValid    = false;
+    stats.confidence = 0;
+    cornerPoints     = {cv::Point2f(0,0), cv::Point2f(0,0), cv::Point2f(0,0), cv::Point2f(0,0)};
+    return new ObjectBox(cornerPoints, 0);
+}
+
+/**
+ * Returns the matched points that were consistent with the homography of the
+ * last analyzed frame, i.e. the RANSAC inliers. The scene points are in the
+ * coordinates of the whole frame. If no homography was found, both are empty.
+ *
+ * @param targetPoints is set to the points in the target image.
+ * @param scenePoints  is set to the corresponding points in the frame.
+ */
+void ObjectDetector::getInlierPoints(std::vector<cv::Point2f> & targetPoints, std::vector<cv::Point2f> & scenePoints)
+{
+    targetPoints = std::vector<cv::Point2f>{};
+    scenePoints  = std::vector<cv::Point2f>{};
+
+    for (int i = 0; i < inlierMask.size() && i < sceneVector.size(); i++) {
+        if (inlierMask[i]) {
+            targetPoints.push_back(targetVector[i]);
+            scenePoints.push_back(sceneVector[i]);
+        }
+    }
+}
+
+/**
+ * Lets the detector measure how long every stage of
+ * processFrameUsingSURFandFLANN() takes. By default nothing is measured, so
+ * the clock is not read in between.
+ *
+ * @param measure whether the stages are measured.
+ */
+void ObjectDetector::measureStages(bool measure)
+{
+    stagesMeasured = measure;
+}
+
+/**
+ * Forgets the last homography, so the next frame is matched fully. It has to
+ * be called whenever the camera moved, because the target is not where the
+ * homography expects it anymore. It can be called from any thread, the
+ * detector drops the guidance before it analyzes its next frame.
+ */
+void ObjectDetector::invalidateGuidance()
+{
+    guidanceInvalidated = true;
+}
+
+/**
+ * Returns the statistics of the last analyzed frame.
+ *
+ * @return the detection stats.
+ */
+DetectionStats ObjectDetector::getStats()
+{
+    return stats;
+}
+
+/**
+ * Returns the name of a stage as it is printed by the benchmark.
+ *
+ * @param  stage a DetectionStats::stage.
+ * @return       the name of the stage.
+ */
+std::string DetectionStats::stageName(int stage)
+{
+    switch (stage) {
+        case colorConversion      : return "color_conversion";
+        case keypointDetection    : return "keypoint_detection";
+        case descriptorExtraction : return "descriptor_extraction";
+        case matching             : return "matching";
+        case matchFiltering       : return "match_filtering";
+        case homography           : return "homography";
+        case objectBox            : return "object_box";
+    }
+    return "unknown";
+}
+
+/**
+ * Rates how much a homography can be trusted, between 0 and 1. It is the
+ * product of
+ * -the share of the good matches that fit the homography,
+ * -the number of inliers relative to DETECTION_CONFIDENT_INLIERS, as a few
+ *  matches can fit a wrong homography by chance,
+ * -how close the inliers are to the homography, the confidence drops to half
+ *  if their mean error is HOMOGRAPHY_REPROJECTION_ERROR.
+ *
+ * @param  inliers    the matches that fit the homography.
+ * @param  matchCount the good matches the homography was fitted to.
+ * @param  residual   the mean reprojection error of the inliers.
+ * @return            the confidence, 0 without inliers.
+ */
+float ObjectDetector::detectionConfidence(int inliers, int matchCount, double residual)
+{
+    if (matchCount <= 0 || inliers <= 0) return 0;
+
+    float inlierRatio = (float) inliers / matchCount;
+    float support     = std::min(1.0f, (float) inliers / DETECTION_CONFIDENT_INLIERS);
+    float accuracy    = 1 - 0.5 * std::min(1.0, residual / HOMOGRAPHY_REPROJECTION_ERROR);
+
+    return inlierRatio * support * accuracy;
+}
+
+// MARK: PRIVATE
+
+/**
+ * Matches the target keypoints with the scene keypoints near where the last
+ * homography expects them. The scene keypoints are sorted into a grid of
+ * guidedRadius sized cells, so only the cells around the expected position
+ * have to be searched. A match has to pass the same ratio test against the
+ * second closest scene keypoint in the radius as a full match. Without a
+ * second scene keypoint in the radius there is nothing to compare with, so
+ * the target keypoint is not matched.
+ * If enough of the guided matches fit the last homography, it is kept.
+ * Otherwise a new one is fitted to the guided matches by the HomographyEstimator.
+ *
+ * @param  regionOrigin the top left corner of the search region in the frame.
+ * @return              whether the guided matches were enough to find the homography.
+ */
+bool ObjectDetector::matchGuided(cv::Point2f regionOrigin)
+{
+    const std::vector<cv::KeyPoint> & targetKeypoints   = targetModel->getTargetKeypoints();
+    const cv::Mat &                   targetDescriptors = targetModel->getObjectDescriptors();
+
+    if (settings.guidedRadius <= 0 || targetKeypoints.empty() || sceneKeypoints.empty()) return false;
+    if (sceneDescriptors.rows != sceneKeypoints.size()) return false;
+
+    targetPoints = std::vector<cv::Point2f>(targetKeypoints.size());
+    for (int i = 0; i < targetKeypoints.size(); i++) targetPoints[i] = targetKeypoints[i].pt;
+    cv::perspectiveTransform(targetPoints, predictedPoints, H);
+
+    float radius  = settings.guidedRadius;
+    int   columns = sceneFrame.cols / radius + 1;
+    int   rows    = sceneFrame.rows / radius + 1;
+
+    guidedGrid.assign(columns * rows, std::vector<int>{});
+    for (int j = 0; j < sceneKeypoints.size(); j++) {
+        guidedGrid[(int) (sceneKeypoints[j].pt.y / radius) * columns + (int) (sceneKeypoints[j].pt.x / radius)].push_back(j);
+    }
+
+    int normType = targetModel->binaryDescriptors() ? cv::NORM_HAMMING : cv::NORM_L2;
+    goodMatches  = std::vector<cv::DMatch>{};
+
+    for (int i = 0; i < predictedPoints.size(); i++) {
+
+        cv::Point2f expected = predictedPoints[i] - regionOrigin;
+        int         column   = std::floor(expected.x / radius);
+        int         row      = std::floor(expected.y / radius);
+
+        int    closest         = -1;
+        double closestDistance = DBL_MAX, secondDistance = DBL_MAX;
+
+        for (int y = std::max(0, row - 1); y <= std::min(rows - 1, row + 1); y++) {
+            for (int x = std::max(0, column - 1); x <= std::min(columns - 1, column + 1); x++) {
+
+                const std::vector<int> & cell = guidedGrid[y * columns + x];
+
+                for (int c = 0; c < cell.size(); c++) {
+                    int j = cell[c];
+                    if (cv::norm(sceneKeypoints[j].pt - expected) > radius) continue;
+
+                    double distance = cv::norm(targetDescriptors.row(i), sceneDescriptors.row(j), normType);
+
+                    if (distance < closestDistance) {
+                        secondDistance  = closestDistance;
+                        closestDistance = distance;
+                        closest         = j;
+                    } else if (distance < secondDistance) {
+                        secondDistance = distance;
+                    }
+                }
+            }
+        }
+
+        if (closest >= 0 && secondDistance < DBL_MAX && closestDistance < settings.ratio * secondDistance) {
+            goodMatches.push_back(cv::DMatch(i, closest, closestDistance));
+        }
+    }
+    finishStage(DetectionStats::matching);
+
+    if (goodMatches.size() < settings.guidedMinMatches) return false;
+
+    targetVector = std::vector<cv::Point2f>{};
+    sceneVector  = std::vector<cv::Point2f>{};
+
+    for (int i = 0; i < goodMatches.size(); i++) {
+        targetVector.push_back(targetKeypoints[goodMatches[i].queryIdx].pt);
+        sceneVector.push_back(sceneKeypoints[goodMatches[i].trainIdx].pt + regionOrigin);
+    }
+
+    // Check whether the target is still where it was.
+    cv::perspectiveTransform(targetVector, projectedPoints, H);
+    inlierMask = std::vector<uchar>(goodMatches.size(), 0);
+    int    inliers    = 0;
+    double errorTotal = 0;
+
+    for (int i = 0; i < projectedPoints.size(); i++) {
+        double error = cv::norm(projectedPoints[i] - sceneVector[i]);
+        if (error <= HOMOGRAPHY_REPROJECTION_ERROR) {
+            inlierMask[i] = 1;
+            inliers++;
+            errorTotal += error;
+        }
+    }
+
+    if (inliers >= GUIDED_HOMOGRAPHY_INLIERS * goodMatches.size()) {
+        stats.inliers  = inliers;
+        stats.residual = inliers > 0 ? errorTotal / inliers : 0;
+        finishStage(DetectionStats::homography);
+        return true;
+    }
+
+    cv::Mat guidedH;
+    bool    estimated = estimateHomography(guidedH);
+    finishStage(DetectionStats::homography);
+
+    if (!estimated || stats.inliers < settings.guidedMinMatches) return false;
+
+    H = guidedH;
+    return true;
+}
+
+/**
+ * Fits the homography to the matches in targetVector and sceneVector with the
+ * HomographyEstimator, the best matches are sampled first. The inliers,
+ * residual and samples are recorded in the stats.
+ *
+ * @param  homography is set to the homography, it is empty if none was found.
+ * @return            whether a homography was found.
+ */
+bool ObjectDetector::estimateHomography(cv::Mat & homography)
+{
+    matchDistances = std::vector<float>{};
+    for (int i = 0; i < goodMatches.size(); i++) matchDistances.push_back(goodMatches[i].distance);
+
+    HomographyFit fit = estimator.estimate(targetVector, sceneVector, matchDistances, inlierMask);
+
+    homography       = fit.H;
+    stats.inliers    = fit.inliers;
+    stats.residual   = fit.residual;
+    stats.iterations = fit.iterations;
+
+    return !homography.empty();
+}
+
+/**
+ * Resets the stage timings and starts measuring the first stage if the stages
+ * are measured.
+ */
+void ObjectDetector::startStages()
+{
+    for (int i = 0; i < DetectionStats::stageCount; i++) stats.milliseconds[i] = 0;
+
+    if (stagesMeasured) stageStart = std::chrono::steady_clock::now();
+}
+
+/**
+ * Records the time since the previous stage finished and starts the next one.
+ * A stage that runs again, e.g. matching after guided matching failed, adds
+ * up its times.
+ *
+ * @param stage the stage that just finished.
+ */
+void ObjectDetector::finishStage(DetectionStats::stage stage)
+{
+    if (!stagesMeasured) return;
+
+    std::chrono::steady_clock::time_point stageEnd = std::chrono::steady_clock::now();
+    stats.milliseconds[stage] += std::chrono::duration<double, std::milli>(stageEnd - stageStart).count();
+    stageStart = stageEnd;
+}
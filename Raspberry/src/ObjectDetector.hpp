@@ -0,0 +1,151 @@
+/*! \class ObjectDetector ObjectDetector.hpp "ObjectDetector.hpp"
+**
+** The ObjectDetector looks for the target object in a single frame and returns
+** an ObjectBox with the corners it found. It owns its own FeatureBackend,
+** TargetMatcher and all the scratch buffers that are
+** needed while a frame is analyzed. The target itself is shared read-only via
+** the TargetModel. This means that several ObjectDetectors can analyze
+** different frames on different threads at the same time.
+**
+** Once the target was found, the next frame can use guided matching. The
+** target keypoints are projected through the last homography and every one
+** of them is only compared with the scene keypoints within guidedRadius of
+** where it is expected. If the last homography still fits those matches, it
+** is kept without RANSAC, otherwise RANSAC only runs on the guided matches.
+** Only if there are too few of them is the frame matched like any other.
+** Every motion of the camera has to invalidate the guidance.
+** The homography is fitted by a HomographyEstimator, which samples the best
+** matches first and does not fit anything if there are too few matches.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef OBJECTDETECTOR_HPP
+#define OBJECTDETECTOR_HPP
+
+#include <iostream>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <string>
+#include "opencv2/opencv.hpp"
+#include "opencv2/core/core.hpp"
+#include "opencv2/features2d/features2d.hpp"
+#include <opencv2/nonfree/features2d.hpp>
+#include "opencv2/calib3d/calib3d.hpp"
+
+#include "TargetModel.hpp"
+#include "TargetMatcher.hpp"
+#include "FeatureBackend.hpp"
+#include "KeypointBudget.hpp"
+#include "HomographyEstimator.hpp"
+#include "SceneCache.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+class ObjectBox;
+
+/** The most pixels a match may be off the homography and still count as an inlier. */
+#define HOMOGRAPHY_REPROJECTION_ERROR 3
+/** The share of guided matches that have to fit the last homography to keep it. */
+#define GUIDED_HOMOGRAPHY_INLIERS 0.8
+/** From this many inliers on, the number of inliers does not lower the confidence of a detection anymore. */
+#define DETECTION_CONFIDENT_INLIERS 40
+
+/**
+ * The settings every ObjectDetector is configured with. They are read from the
+ * properties file by the VideoProcessor.
+ */
+struct DetectorSettings
+{
+    TargetMatcher::matcherType matcherType;
+    float                      ratio;
+    int                        keypointTarget; // 0 keeps the hessian threshold fixed.
+    int                        maxKeypoints;   // 0 keeps all keypoints.
+    double                     minHessian, maxHessian;
+    bool                       frameDebuggingOutput;
+    bool                       guidedMatching;
+    float                      guidedRadius;     // in pixels.
+    int                        guidedMinMatches;
+    HomographyEstimator::modelType homographyModel;
+};
+
+/**
+ * Statistics of the last frame processFrameUsingSURFandFLANN() analyzed.
+ * How long every stage took is only measured for the benchmark, see
+ * measureStages(). If the FeatureBackend detects and computes in a single
+ * pass or in tiles, all of it is counted as keypointDetection.
+ */
+struct DetectionStats
+{
+    enum stage {
+        colorConversion,
+        keypointDetection,
+        descriptorExtraction,
+        matching,
+        matchFiltering,
+        homography,
+        objectBox,
+        stageCount
+    };
+
+    double milliseconds[stageCount];
+    int    keypoints;        // detected in the search region, before maxKeypoints was applied.
+    double hessianThreshold; // the surf threshold the frame was analyzed with, 0 for other backends.
+    bool   guided;           // whether the frame was matched through the last homography.
+    int    inliers;          // the matches that fit the homography.
+    double residual;         // the mean reprojection error of the inliers in pixels.
+    int    iterations;       // the samples the HomographyEstimator drew, 0 if the last homography was kept.
+    float  confidence;       // the confidence of the returned ObjectBox, see detectionConfidence().
+
+    static std::string stageName(int stage);
+};
+
+class ObjectDetector {
+
+public:
+
+    ObjectDetector(TargetModel * targetModel, DetectorSettings settings, SceneCache * sceneCache = NULL);
+    ObjectBox * processFrameUsingSURFandFLANN(cv::Mat currentFrame, cv::Rect searchRegion = cv::Rect());
+    void        getInlierPoints(std::vector<cv::Point2f> & targetPoints, std::vector<cv::Point2f> & scenePoints);
+    void        measureStages(bool measure);
+    void        invalidateGuidance();
+    DetectionStats getStats();
+
+    static float detectionConfidence(int inliers, int matchCount, double residual);
+
+private:
+
+    TargetModel *    targetModel;
+    DetectorSettings settings;
+    SceneCache *     sceneCache;
+
+    cv::Mat sceneFrame, sceneDescriptors, sceneSignature, H;
+    FeatureBackend              features;
+    std::vector<cv::KeyPoint>   sceneKeypoints;
+    TargetMatcher               matcher;
+    std::vector<cv::DMatch>     goodMatches;
+    std::vector<cv::Point2f>    targetVector, sceneVector;
+    std::vector<uchar>          inlierMask;
+    std::array<cv::Point2f, 4>  cornerPoints;
+    KeypointBudget              keypointBudget;
+    HomographyEstimator         estimator;
+    std::vector<float>          matchDistances;
+    bool                        guidanceValid;
+    std::atomic<bool>           guidanceInvalidated;
+    std::vector<cv::Point2f>    targetPoints, predictedPoints, projectedPoints;
+    std::vector< std::vector<int> > guidedGrid;
+
+    DetectionStats                        stats;
+    bool                                  stagesMeasured;
+    std::chrono::steady_clock::time_point stageStart;
+
+    bool matchGuided(cv::Point2f regionOrigin);
+    bool estimateHomography(cv::Mat & homography);
+    void startStages();
+    void finishStage(DetectionStats::stage stage);
+};
+
+#endif //OBJECTDETECTOR_HPP
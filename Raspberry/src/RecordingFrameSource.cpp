@@ -0,0 +1,125 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "RecordingFrameSource.hpp"
+
+/**
+ * Creates the recording and writes its header.
+ *
+ * @param source  the FrameSource the frames are read from.
+ * @param path    where the recording is written to. An existing file is overwritten.
+ * @param format  the image format of the frames, ".jpg" or ".png".
+ * @param quality the JPEG quality (0 - 100), not used for PNG.
+ */
+RecordingFrameSource::RecordingFrameSource(FrameSource * source, std::string path, std::string format, int quality)
+{
+    Logger::debug("RecordingFrameSource Constructor");
+    this->source = source;
+    this->path   = path;
+    this->format = format;
+    fileSize     = 0;
+
+    if (format == ".jpg") {
+        encodingParameters = {CV_IMWRITE_JPEG_QUALITY, quality};
+    } else if (format != ".png") {
+        throw InvalidPropertyException("vp_recording_format", format);
+    }
+
+    file = fopen(path.c_str(), "wb");
+    if (file == NULL) throw RecordingException(path, "Can not create recording");
+
+    FrameRecordingHeader header = {};
+    memcpy(header.magic, FRAME_RECORDING_MAGIC, sizeof(header.magic));
+    header.version = FRAME_RECORDING_VERSION;
+    write(&header, sizeof(header));
+    fflush(file);
+}
+
+/**
+ * Closes the recording.
+ */
+RecordingFrameSource::~RecordingFrameSource()
+{
+    close();
+}
+
+/**
+ * Reads the next frame from the source and appends it to the recording. The
+ * entry is flushed right away, so the recording can still be replayed if the
+ * program does not end properly.
+ *
+ * @param  frame is set to the frame.
+ * @return false if the source did not deliver a frame.
+ */
+bool RecordingFrameSource::read(cv::Mat & frame)
+{
+    if (!source->read(frame) || frame.empty()) return false;
+
+    std::chrono::steady_clock::time_point captureTime = std::chrono::steady_clock::now();
+    if (entries.empty()) firstCaptureTime = captureTime;
+
+    if (file == NULL) return true;
+
+    cv::imencode(format, frame, encodedFrame, encodingParameters);
+
+    FrameRecordingEntry entry = {};
+    entry.captureTime = std::chrono::duration_cast<std::chrono::microseconds>(captureTime - firstCaptureTime).count();
+    entry.offset      = fileSize + sizeof(entry);
+    entry.size        = encodedFrame.size();
+
+    write(&entry, sizeof(entry));
+    write(encodedFrame.data(), encodedFrame.size());
+    fflush(file);
+
+    entries.push_back(entry);
+    return true;
+}
+
+/**
+ * A recording is live if its source is.
+ *
+ * @return whether the source is live.
+ */
+bool RecordingFrameSource::live()
+{
+    return source->live();
+}
+
+/**
+ * Writes the index and the final header and closes the file. Frames that are
+ * read afterwards are not recorded anymore.
+ */
+void RecordingFrameSource::close()
+{
+    if (file == NULL) return;
+
+    FrameRecordingHeader header = {};
+    memcpy(header.magic, FRAME_RECORDING_MAGIC, sizeof(header.magic));
+    header.version     = FRAME_RECORDING_VERSION;
+    header.frameCount  = entries.size();
+    header.indexOffset = fileSize;
+
+    if (!entries.empty()) write(entries.data(), entries.size() * sizeof(FrameRecordingEntry));
+
+    fseek(file, 0, SEEK_SET);
+    write(&header, sizeof(header));
+    fclose(file);
+    file = NULL;
+
+    printf("RecordingFrameSource: %zu frames recorded to %s\n", entries.size(), path.c_str());
+}
+
+// MARK: PRIVATE
+
+/**
+ * Writes data to the end of the recording.
+ *
+ * @param data the data to write.
+ * @param size the number of bytes.
+ */
+void RecordingFrameSource::write(const void * data, size_t size)
+{
+    if (fwrite(data, 1, size, file) != size) throw RecordingException(path, "Can not write recording");
+    fileSize += size;
+}
@@ -0,0 +1,52 @@
+/*! \class RecordingFrameSource RecordingFrameSource.hpp "RecordingFrameSource.hpp"
+**
+** The RecordingFrameSource reads its frames from another FrameSource and
+** writes every one of them with the time it was captured into a recording
+** (see FrameRecording.hpp). The frames are encoded as JPEG or PNG, so a
+** recording is a lot smaller than the raw frames. It can be replayed with the
+** ReplayFrameSource.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef RECORDINGFRAMESOURCE_HPP
+#define RECORDINGFRAMESOURCE_HPP
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "opencv2/core/core.hpp"
+#include "opencv2/highgui/highgui.hpp"
+
+#include "FrameSource.hpp"
+#include "FrameRecording.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+class RecordingFrameSource : public FrameSource {
+
+public:
+
+    RecordingFrameSource(FrameSource * source, std::string path, std::string format, int quality);
+    ~RecordingFrameSource();
+    bool read(cv::Mat & frame);
+    bool live();
+    void close();
+
+private:
+
+    FrameSource *                    source;
+    std::string                      path, format;
+    std::vector<int>                 encodingParameters;
+    FILE *                           file;
+    uint64_t                         fileSize;
+    std::vector<FrameRecordingEntry> entries;
+    std::vector<uchar>               encodedFrame;
+    std::chrono::steady_clock::time_point firstCaptureTime;
+
+    void write(const void * data, size_t size);
+};
+
+#endif //RECORDINGFRAMESOURCE_HPP
@@ -6,6 +6,15 @@
 */
 
 #include "RelativePosition.hpp"
+#include "TargetEstimator.hpp"
+
+/**
+ * A sample ObjectBox and the time it was added to the history.
+ */
+struct RelativePosition::TimedSample {
+    ObjectBox sampleBox;
+    std::chrono::steady_clock::time_point time;
+};
 
 
 // MARK: Constructors
@@ -18,6 +27,22 @@ RelativePosition::RelativePosition()
     Logger::debug("RelativePosition Constructor");
     cameraCenter  = cv::Point(WEBCAM_WIDTH/2,WEBCAM_HEIGHT/2);
     screenArea    = WEBCAM_WIDTH * WEBCAM_HEIGHT;
+    objectBox     = NULL;
+
+    Properties * properties = Properties::getInstance();
+    sequentialSampling      = properties->getNumberPropertyWithName("vp_sequential_sampling") == 1;
+    consensusSamples        = properties->getNumberPropertyWithName("vp_consensus_samples");
+    consensusTolerance      = properties->getFloatPropertyWithName("vp_consensus_tolerance");
+    emptySamples            = properties->getNumberPropertyWithName("vp_empty_samples");
+    historyMaxAge           = properties->getNumberPropertyWithName("vp_history_max_age");
+    keepHistory             = properties->getNumberPropertyWithName("vp_history_size") > 0;
+    // The ring has to hold the samples of one decision, even without a history.
+    sampleHistory           = new RingBuffer<TimedSample>(std::max(properties->getNumberPropertyWithName("vp_history_size"),
+                                                                   properties->getNumberPropertyWithName("vp_sample_size")));
+    estimator               = new TargetEstimator();
+    predicted               = false;
+    sceneUnchanged          = false;
+    activeTarget            = 0;
     //cv::Point2f x = cv::Point2f(0,0);
     //std::array<cv::Point2f, 4> temp = {x,x,x,x};
     //objectBox     = new ObjectBox(temp);
@@ -48,23 +73,225 @@ cv::Point2f RelativePosition::getObjectCenter()
 }
 
 /**
- * Appends an ObjectBox to the sampleObjectBoxes array.
+ * Appends an ObjectBox to the sample history. If the history is full the
+ * oldest sample is dropped.
+ * A box from the SceneCache repeats the detection of an earlier sample of the
+ * unchanged scene, so it is only added if there is no sample at all. Either
+ * way the scene will not tell anything new, so sampling stops.
  * @param newSample is ObjectBox to append.
  */
 void RelativePosition::addSampleBox(ObjectBox * newSampleBox)
 {
-    sampleObjectBoxes.push_back(ObjectBox(*newSampleBox));
+    if (newSampleBox->isCached()) {
+        sceneUnchanged = true;
+        updateSampleWindow();
+        if (!sampleObjectBoxes.empty()) return;
+    }
+    sampleHistory->push(TimedSample{ObjectBox(*newSampleBox), std::chrono::steady_clock::now()});
+}
+
+/**
+ * Adds the samples of one frame with several targets, one ObjectBox per
+ * target. The sample of the active target is added to the sample history like
+ * any other sample, the others are kept until the next processSampleBoxes().
+ * The ObjectBoxes are deleted.
+ *
+ * @param targetSamples the ObjectBox of every target.
+ */
+void RelativePosition::addTargetSampleBoxes(std::vector<ObjectBox *> targetSamples)
+{
+    if (targetSampleBoxes.size() != targetSamples.size()) {
+        targetSampleBoxes.resize(targetSamples.size());
+        targetObjectBoxes.resize(targetSamples.size(), NULL);
+        if (activeTarget >= targetSamples.size()) activeTarget = 0;
+    }
+
+    for (int t = 0; t < targetSamples.size(); t++) targetSampleBoxes[t].push_back(ObjectBox(*targetSamples[t]));
+
+    if (!targetSamples.empty()) addSampleBox(targetSamples[activeTarget]);
+
+    for (int t = 0; t < targetSamples.size(); t++) delete targetSamples[t];
 }
 
 /**
  * The sampleBoxes are processed by passing them to the ObjectBox constructor.
  * This returns the main ObjectBox that is used for further calculations.
+ * Without a history the samples are dropped afterwards, so the next decision
+ * starts with new samples.
  *
  * @method RelativePosition::processSampleBoxes
  */
 void RelativePosition::processSampleBoxes()
 {
-    objectBox = new ObjectBox(sampleObjectBoxes);
+    updateSampleWindow();
+    if (sequentialSampling) findConsensusGroup();
+
+    if (!sequentialSampling || consensusGroup.size() < consensusSamples) {
+        objectBox = new ObjectBox(sampleObjectBoxes);
+    } else {
+        // Only fuse the samples that agree, the others would pull the corners off.
+        std::vector<ObjectBox> agreeingBoxes;
+        for (int i = 0; i < consensusGroup.size(); i++) {
+            agreeingBoxes.push_back(sampleObjectBoxes[consensusGroup[i]]);
+        }
+        objectBox = new ObjectBox(agreeingBoxes);
+    }
+
+    fuseTargetSamples();
+    if (!keepHistory) sampleHistory->clear();
+
+    predicted      = false;
+    sceneUnchanged = false;
+    if (objectBox->objectDetected()) estimator->correct(*objectBox);
+    else                             estimator->reset();
+}
+
+/**
+ * Clears the sample history. This is necessary whenever the camera moved,
+ * because the samples do not show the current scene anymore.
+ */
+void RelativePosition::clearSampleBoxes()
+{
+    sampleHistory->clear();
+    sampleObjectBoxes.clear();
+    consensusGroup.clear();
+    sceneUnchanged = false;
+    for (int t = 0; t < targetSampleBoxes.size(); t++) targetSampleBoxes[t].clear();
+}
+
+/**
+ * Returns a copy of the sample boxes of the last decision, e.g. to draw them.
+ *
+ * @return the sample boxes.
+ */
+std::vector<ObjectBox> RelativePosition::getSampleBoxes()
+{
+    return sampleObjectBoxes;
+}
+
+/**
+ * Returns how many more sample boxes are needed before the next decision can
+ * be made. Samples from the history that are still valid count as well.
+ * Without sequential sampling this is simply the number of samples missing to
+ * maxSamples.
+ * With sequential sampling it is 0 as soon as consensusSamples samples agree,
+ * the first emptySamples samples did not contain the target, or the samples
+ * can not agree anymore with the samples that are left. Otherwise it is the
+ * smallest number of samples that could lead to one of these decisions.
+ * Once a sample came from the SceneCache no more samples are taken, the
+ * scene did not change.
+ *
+ * @param  maxSamples the most samples that are taken for one decision.
+ * @return            the number of samples to take next, 0 to stop sampling.
+ */
+int RelativePosition::samplesNeeded(int maxSamples)
+{
+    updateSampleWindow();
+
+    int taken     = sampleObjectBoxes.size();
+    int remaining = maxSamples - taken;
+
+    if (remaining <= 0)      return 0;
+    if (sceneUnchanged)      return 0;
+    if (!sequentialSampling) return remaining;
+
+    findConsensusGroup();
+    int agreeing = consensusGroup.size();
+
+    if (agreeing >= consensusSamples)             return 0;
+    if (agreeing + remaining < consensusSamples)  return 0;
+
+    if (agreeing == 0) {
+        if (taken >= emptySamples) return 0;
+        return std::min(remaining, std::min(emptySamples - taken, consensusSamples));
+    }
+    return std::min(remaining, consensusSamples - agreeing);
+}
+
+/**
+ * Returns the ObjectBox that was generated from the last samples.
+ *
+ * @return the ObjectBox or NULL if no samples were processed yet.
+ */
+ObjectBox * RelativePosition::getObjectBox()
+{
+    return objectBox;
+}
+
+/**
+ * Returns the number of targets samples were added for with
+ * addTargetSampleBoxes(), 0 if there is only the single target.
+ *
+ * @return target count
+ */
+int RelativePosition::getTargetCount()
+{
+    return targetObjectBoxes.size();
+}
+
+/**
+ * Returns the ObjectBox that was fused from the last samples of a target.
+ *
+ * @param  target the index of the target.
+ * @return        the ObjectBox or NULL if no samples of it were processed yet.
+ */
+ObjectBox * RelativePosition::getTargetObjectBox(int target)
+{
+    return targetObjectBoxes[target];
+}
+
+/**
+ * Returns the target whose samples are used for the decisions, i.e. the one
+ * getObjectBox() belongs to.
+ *
+ * @return the index of the active target.
+ */
+int RelativePosition::getActiveTarget()
+{
+    return activeTarget;
+}
+
+
+// MARK: Prediction
+
+/**
+ * Tells the TargetEstimator how the camera moved. If the motion is not known
+ * (e.g. the launcher moved or the vehicle drove for an unknown time) the
+ * estimate is dropped.
+ *
+ * @param pixelShift  how many pixels the image is expected to have moved to the right.
+ * @param driveTime   how long the vehicle drove forward (negative: backward) in milliseconds.
+ * @param motionKnown whether pixelShift and driveTime describe all of the motion.
+ */
+void RelativePosition::applyCameraMotion(int pixelShift, int driveTime, bool motionKnown)
+{
+    if (motionKnown) estimator->predict(pixelShift, driveTime);
+    else             estimator->reset();
+}
+
+/**
+ * Replaces the ObjectBox with the prediction of the TargetEstimator, if the
+ * prediction is certain enough.
+ *
+ * @return whether the prediction is used.
+ */
+bool RelativePosition::usePrediction()
+{
+    if (!estimator->isReliable()) return false;
+
+    objectBox = new ObjectBox(estimator->predictedObjectBox());
+    predicted = true;
+    return true;
+}
+
+/**
+ * Returns whether the ObjectBox is a prediction rather than a detection.
+ *
+ * @return true if it was predicted.
+ */
+bool RelativePosition::objectBoxIsPredicted()
+{
+    return predicted;
 }
 
 
@@ -81,6 +308,16 @@ bool RelativePosition::objectDetected()
     return objectBox->objectDetected();
 }
 
+/**
+ * Returns how much the ObjectBox can be trusted, see ObjectBox::getConfidence().
+ *
+ * @return confidence between 0 and 1
+ */
+float RelativePosition::getConfidence()
+{
+    return objectBox->getConfidence();
+}
+
 /**
  * Calculates whether the ObjectBox (minus a certain threashold) intersects the
  * cameraCenter on the horizontal and the vertical axis. This is important information
@@ -158,75 +395,90 @@ RelativePosition::side RelativePosition::whichSideOfTheLauncherIsTheObjectLocate
 */
 
 
-// MARK: Drawing functions
+// MARK: PRIVATE
 
 /**
- * This function draws its classes relevant Kexpoints onto the frame it is passed.
- * This helps when visually debugging.
- *
- * @param frame  the frame to draw on
- * @param origin the offset to draw everything to in the x axis so that it ende
- *               up in the right place.
+ * Fuses the samples of every target that were added since the last call into
+ * one ObjectBox per target. If the active target was not detected, the most
+ * confident target that was detected becomes active. Its ObjectBox replaces
+ * the one of the old target and the sample history, which only holds samples
+ * of the old target, is cleared.
+ * Without new samples the ObjectBoxes of the last call are kept.
  */
-void RelativePosition::drawKeyPointsOntoCVMat(cv::Mat &frame, cv::Point2f origin)
-{   // TODO: maybe make origin a pointer.
-    float letterSize = 2.0;
+void RelativePosition::fuseTargetSamples()
+{
+    if (targetSampleBoxes.empty() || targetSampleBoxes[0].empty()) return;
 
-    for (int i=0; i<sampleObjectBoxes.size(); i++) {
-        sampleObjectBoxes[i].drawBorders(frame, origin);
-    }
+    int bestTarget = -1;
+
+    for (int t = 0; t < targetSampleBoxes.size(); t++) {
+        targetObjectBoxes[t] = new ObjectBox(targetSampleBoxes[t]);
+        targetSampleBoxes[t].clear();
 
-    if (objectDetected()) {
-        objectBox->drawBorders(frame, origin);
-        objectBox->drawCorners(frame, origin, green, false);
-        //objectBox->drawCenterOffset(frame, origin, green);
+        if (t == activeTarget || !targetObjectBoxes[t]->objectDetected()) continue;
+        if (bestTarget < 0 || targetObjectBoxes[t]->getConfidence() > targetObjectBoxes[bestTarget]->getConfidence()) bestTarget = t;
     }
 
-    drawText(frame, origin);
-    clearSampleBoxes();
+    if (objectBox->objectDetected() || bestTarget < 0) return;
+
+    printf("Target %d lost, switching to target %d\n", activeTarget, bestTarget);
+    activeTarget = bestTarget;
+    objectBox    = new ObjectBox(*targetObjectBoxes[bestTarget]);
+    sampleHistory->clear();
+    sampleObjectBoxes.clear();
+    consensusGroup.clear();
 }
 
 /**
- * This function draws statistics to a frame.
- *
- * @method RelativePosition::drawText
- * @param frame  the frame to draw on
- * @param origin the offset to draw everything to in the x axis so that it ende
- *               up in the right place.
+ * Collects the samples of the history that are not older than historyMaxAge
+ * into sampleObjectBoxes, the oldest first.
  */
-void RelativePosition::drawText(cv::Mat &frame, cv::Point2f origin)
+void RelativePosition::updateSampleWindow()
 {
-    int letterThickness = 1;
-    if (objectDetected()) {
-        cv::putText(frame, "area  : " +  std::to_string(getRelativeObjectArea()),            cv::Point2f(5, 20) + origin, 1, 1.0, green, letterThickness );
-        cv::putText(frame, "deltaX: " +  std::to_string(distanceOfObjectToCameraCenter().x), cv::Point2f(5, 40) + origin, 1, 1.0, green, letterThickness );
-        cv::putText(frame, "deltaY: " +  std::to_string(distanceOfObjectToCameraCenter().y), cv::Point2f(5, 60) + origin, 1, 1.0, green, letterThickness );
-    }
+    std::chrono::steady_clock::time_point oldest = std::chrono::steady_clock::now() - std::chrono::milliseconds(historyMaxAge);
 
-/*
-    // This text label represents the relative position of the robot to the target object.
-    std::string sideString = "none";
-    if (objectDetected()) {
-        RelativePosition::side tempSide = whichSideOfTheLauncherIsTheObjectLocatedAt();
-        switch(tempSide) {
-            case RelativePosition::side::streightAhead: sideString = "center"; break;
-            case RelativePosition::side::left: sideString = "left"; break;
-            case RelativePosition::side::right: sideString = "right"; break;
-        }
+    sampleObjectBoxes.clear();
+    for (int i = 0; i < sampleHistory->size(); i++) {
+        if ((*sampleHistory)[i].time >= oldest) sampleObjectBoxes.push_back((*sampleHistory)[i].sampleBox);
     }
-    cv::putText(frame, "side: " + sideString, cv::Point2f(5, 80) + origin, 1, 1.0, green, letterThickness );
-    */
 }
 
+/**
+ * Finds the largest group of relevant sample boxes that agree with one of them
+ * and saves their indices in consensusGroup.
+ */
+void RelativePosition::findConsensusGroup()
+{
+    consensusGroup.clear();
 
-// MARK: PRIVATE
+    for (int i = 0; i < sampleObjectBoxes.size(); i++) {
+        if (!sampleObjectBoxes[i].isRelevant()) continue;
+
+        std::vector<int> group;
+        for (int j = 0; j < sampleObjectBoxes.size(); j++) {
+            if (sampleObjectBoxes[j].isRelevant() && samplesAgree(sampleObjectBoxes[i], sampleObjectBoxes[j])) {
+                group.push_back(j);
+            }
+        }
+        if (group.size() > consensusGroup.size()) consensusGroup = group;
+    }
+}
 
 /**
- * Clears the sample boxes array. After processing and drawing the sample boxes
- * they are not needed anymore and need to be cleared before new sample boxes
- * get saved.
+ * Two sample boxes agree if each of their corners are at most
+ * consensusTolerance pixels apart.
+ *
+ * @param  first  the first sample box.
+ * @param  second the second sample box.
+ * @return        whether they agree.
  */
-void RelativePosition::clearSampleBoxes()
+bool RelativePosition::samplesAgree(ObjectBox & first, ObjectBox & second)
 {
-    sampleObjectBoxes.clear();
+    std::array<cv::Point2f, 4> firstCorners  = first.getObjectCornerPoints();
+    std::array<cv::Point2f, 4> secondCorners = second.getObjectCornerPoints();
+
+    for (int i = 0; i < 4; i++) {
+        if (cv::norm(firstCorners[i] - secondCorners[i]) > consensusTolerance) return false;
+    }
+    return true;
 }
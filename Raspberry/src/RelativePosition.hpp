@@ -6,6 +6,28 @@
 ** the object. This is needed in other classes to make decisions on how to move
 ** the robot to get into a better position.
 **
+** With sequential sampling the RelativePosition also decides how many sample
+** ObjectBoxes are needed. Sampling stops as soon as enough samples agree on
+** the corners of the target, or the first samples all missed it. More frames
+** are only taken while the samples disagree. The agreeing samples are then the
+** only ones that are fused.
+**
+** The sample ObjectBoxes are kept in a ring with the time they were added.
+** Every decision is made from the samples that are not older than
+** historyMaxAge, so as long as the robot does not move, earlier samples are
+** reused and new frames are only needed once they get too old. Moving the
+** vehicle or the launcher makes all samples invalid. Without a history size
+** the samples are only kept until the decision they were taken for.
+**
+** With several targets every frame yields one sample per target. The samples
+** of the active target go through the decision above, the others are only
+** fused into one ObjectBox per target. If the active target is not detected
+** anymore, the most confident other target that was detected becomes active.
+**
+** A TargetEstimator follows the detected ObjectBoxes and the commanded motion
+** of the vehicle. Right after a move its prediction can be used as ObjectBox,
+** so the next decision does not have to wait for new samples.
+**
 ** @author Daniel Palenicek
 ** @version 0.1 / 29.08.2016
 **
@@ -16,14 +38,20 @@
 #define RELATIVEPOSITION_HPP
 
 #include <array>
+#include <vector>
+#include <algorithm>
+#include <chrono>
 #include <stdio.h>
 #include <iostream>
 #include "opencv2/features2d/features2d.hpp"
 #include "VideoProcessor.hpp"
 #include "ObjectBox.hpp"
+#include "Properties.hpp"
+#include "RingBuffer.hpp"
 #include "Logger.hpp"
 
 class ObjectBox;
+class TargetEstimator;
 
 class RelativePosition {
 
@@ -39,35 +67,61 @@ public:
     float       getRelativeObjectArea();
     cv::Point2f getObjectCenter();
     void        addSampleBox(ObjectBox * newSample);
+    void        addTargetSampleBoxes(std::vector<ObjectBox *> targetSamples);
     void        processSampleBoxes();
+    void        clearSampleBoxes();
+    std::vector<ObjectBox> getSampleBoxes();
+    ObjectBox * getObjectBox();
+    int         getTargetCount();
+    ObjectBox * getTargetObjectBox(int target);
+    int         getActiveTarget();
+    int         samplesNeeded(int maxSamples);
+
+    // MARK: Prediction
+    void applyCameraMotion(int pixelShift, int driveTime, bool motionKnown);
+    bool usePrediction();
+    bool objectBoxIsPredicted();
 
     // MARK: Other functions
     bool objectDetected();
+    float getConfidence();
     bool cameraCenterIntersectsTarget();
     bool cameraCenterIntersectsTargetHorizontaly();
     bool cameraCenterIntersectsTargetVerticaly();
     cv::Point2f distanceOfObjectToCameraCenter();
 
-    // MARK: Drawing functions
-    void  drawKeyPointsOntoCVMat(cv::Mat &frame, cv::Point2f origin);
-    void  drawText(cv::Mat &frame, cv::Point2f origin);
-
     // MARK: Destructor
     ~RelativePosition() {};
 
 private:
     // MARK: PRIVATE
-    std::vector<ObjectBox> sampleObjectBoxes;
+    // Defined in the .cpp, ObjectBox is not complete here because of the include cycle.
+    struct TimedSample;
+
+    TargetEstimator *         estimator;
+    bool                      predicted, keepHistory;
+    RingBuffer<TimedSample> * sampleHistory;
+    int                       historyMaxAge;
+    std::vector<ObjectBox>    sampleObjectBoxes;
     ObjectBox * objectBox;
     cv::Point2f cameraCenter;
     float       screenArea;
 
-    void  clearSampleBoxes();
-
-    // MARK: colors
-    cv::Scalar green = cv::Scalar(0, 255, 0);
-    cv::Scalar red   = cv::Scalar(0, 0, 128);
-    std::vector<cv::Scalar> colors = {cv::Scalar(255, 0, 0), cv::Scalar(255, 255, 0), cv::Scalar(255, 255, 255), cv::Scalar(255, 0, 255)};
+    // sequential sampling properties
+    bool             sequentialSampling, sceneUnchanged;
+    int              consensusSamples, emptySamples;
+    float            consensusTolerance;
+    std::vector<int> consensusGroup;
+
+    // multi target properties
+    int                                  activeTarget;
+    std::vector< std::vector<ObjectBox> > targetSampleBoxes;
+    std::vector<ObjectBox *>             targetObjectBoxes;
+
+    void fuseTargetSamples();
+    void updateSampleWindow();
+    void findConsensusGroup();
+    bool samplesAgree(ObjectBox & first, ObjectBox & second);
 
 };
 
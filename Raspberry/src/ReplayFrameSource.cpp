@@ -0,0 +1,180 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "ReplayFrameSource.hpp"
+
+/**
+ * Maps the recording into memory and reads its index.
+ *
+ * @param path     the recording to replay.
+ * @param realTime whether the frames are delivered at the pace they were recorded at.
+ */
+ReplayFrameSource::ReplayFrameSource(std::string path, bool realTime)
+{
+    Logger::debug("ReplayFrameSource Constructor");
+    this->path     = path;
+    this->realTime = realTime;
+    paceStarted    = false;
+    nextFrame      = 0;
+
+    fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor == -1) throw FileNotFoundException(path);
+
+    struct stat fileStatus;
+    fstat(fileDescriptor, &fileStatus);
+    fileSize = fileStatus.st_size;
+
+    if (fileSize < sizeof(FrameRecordingHeader)) {
+        ::close(fileDescriptor);
+        throw RecordingException(path, "Not a recording");
+    }
+
+    void * mapping = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+        ::close(fileDescriptor);
+        throw RecordingException(path, "Can not map recording");
+    }
+    data = (const uchar *) mapping;
+
+    try {
+        readIndex();
+    }
+    catch (...) {
+        munmap(mapping, fileSize);
+        ::close(fileDescriptor);
+        throw;
+    }
+}
+
+/**
+ * Unmaps the recording.
+ */
+ReplayFrameSource::~ReplayFrameSource()
+{
+    munmap((void *) data, fileSize);
+    ::close(fileDescriptor);
+}
+
+/**
+ * Decodes the next frame of the recording. In real time this waits until the
+ * frame is due.
+ *
+ * @param  frame is set to the frame.
+ * @return true
+ */
+bool ReplayFrameSource::read(cv::Mat & frame)
+{
+    if (nextFrame >= entries.size()) throw EndOfRecordingException(path);
+
+    FrameRecordingEntry & entry = entries[nextFrame];
+
+    if (realTime) {
+        if (!paceStarted) {
+            paceStart            = std::chrono::steady_clock::now();
+            paceStartCaptureTime = entry.captureTime;
+            paceStarted          = true;
+        }
+        std::this_thread::sleep_until(paceStart + std::chrono::microseconds(entry.captureTime - paceStartCaptureTime));
+    }
+
+    cv::Mat encodedFrame(1, entry.size, CV_8U, (void *) (data + entry.offset));
+    frame = cv::imdecode(encodedFrame, CV_LOAD_IMAGE_COLOR);
+
+    nextFrame++;
+    return !frame.empty();
+}
+
+/**
+ * A replay has no camera buffer that would have to be skipped.
+ *
+ * @return false
+ */
+bool ReplayFrameSource::live()
+{
+    return false;
+}
+
+/**
+ * Returns the number of frames in the recording.
+ *
+ * @return frame count
+ */
+int ReplayFrameSource::getFrameCount()
+{
+    return entries.size();
+}
+
+/**
+ * Makes the frame at frameIndex the next one to be read. In real time the
+ * pace starts again from that frame.
+ *
+ * @param frameIndex the index of the frame, 0 is the first one.
+ */
+void ReplayFrameSource::seek(int frameIndex)
+{
+    nextFrame   = std::max(0, std::min(frameIndex, (int) entries.size()));
+    paceStarted = false;
+}
+
+/**
+ * Returns when a frame was captured.
+ *
+ * @param  frameIndex the index of the frame.
+ * @return            microseconds since the first frame was captured.
+ */
+int64_t ReplayFrameSource::getCaptureTime(int frameIndex)
+{
+    return entries[frameIndex].captureTime;
+}
+
+// MARK: PRIVATE
+
+/**
+ * Checks the header and reads the index at the end of the recording. If there
+ * is none, because the recording was not closed, the entries are collected
+ * from the frames themselves.
+ */
+void ReplayFrameSource::readIndex()
+{
+    FrameRecordingHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, FRAME_RECORDING_MAGIC, sizeof(header.magic)) != 0) {
+        throw RecordingException(path, "Not a recording");
+    }
+    if (header.version != FRAME_RECORDING_VERSION) {
+        throw RecordingException(path, "Unsupported recording version " + std::to_string(header.version));
+    }
+
+    uint64_t indexSize = (uint64_t) header.frameCount * sizeof(FrameRecordingEntry);
+
+    if (header.indexOffset == 0 || header.indexOffset + indexSize > fileSize) {
+        scanEntries();
+        return;
+    }
+
+    entries.resize(header.frameCount);
+    if (indexSize > 0) memcpy(entries.data(), data + header.indexOffset, indexSize);
+}
+
+/**
+ * Walks through the frames of a recording that has no index. A frame that was
+ * only written partially ends the recording.
+ */
+void ReplayFrameSource::scanEntries()
+{
+    uint64_t position = sizeof(FrameRecordingHeader);
+
+    while (position + sizeof(FrameRecordingEntry) <= fileSize) {
+        FrameRecordingEntry entry;
+        memcpy(&entry, data + position, sizeof(entry));
+
+        if (entry.offset != position + sizeof(entry) || entry.offset + entry.size > fileSize) break;
+
+        entries.push_back(entry);
+        position = entry.offset + entry.size;
+    }
+
+    printf("ReplayFrameSource: %s has no index, found %zu frames\n", path.c_str(), entries.size());
+}
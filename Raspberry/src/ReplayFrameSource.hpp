@@ -0,0 +1,63 @@
+/*! \class ReplayFrameSource ReplayFrameSource.hpp "ReplayFrameSource.hpp"
+**
+** The ReplayFrameSource reads the frames of a recording that was written by
+** the RecordingFrameSource. The recording is mapped into memory, so reading a
+** frame only means decoding it and any frame can be jumped to with seek().
+** In real time the frames are delivered at the pace they were recorded at,
+** just like from the camera. Otherwise they are delivered as fast as they are
+** read, which is what benchmarks and offline runs want.
+** Reading past the last frame throws an EndOfRecordingException.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef REPLAYFRAMESOURCE_HPP
+#define REPLAYFRAMESOURCE_HPP
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include "opencv2/core/core.hpp"
+#include "opencv2/highgui/highgui.hpp"
+
+#include "FrameSource.hpp"
+#include "FrameRecording.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+class ReplayFrameSource : public FrameSource {
+
+public:
+
+    ReplayFrameSource(std::string path, bool realTime);
+    ~ReplayFrameSource();
+    bool    read(cv::Mat & frame);
+    bool    live();
+    int     getFrameCount();
+    void    seek(int frameIndex);
+    int64_t getCaptureTime(int frameIndex);
+
+private:
+
+    std::string                      path;
+    bool                             realTime, paceStarted;
+    int                              fileDescriptor;
+    const uchar *                    data;
+    size_t                           fileSize;
+    std::vector<FrameRecordingEntry> entries;
+    int                              nextFrame;
+    std::chrono::steady_clock::time_point paceStart;
+    int64_t                          paceStartCaptureTime;
+
+    void readIndex();
+    void scanEntries();
+};
+
+#endif //REPLAYFRAMESOURCE_HPP
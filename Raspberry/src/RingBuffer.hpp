@@ -0,0 +1,66 @@
+/*! \class RingBuffer RingBuffer.hpp "RingBuffer.hpp"
+**
+** The RingBuffer keeps the last elements that were pushed into it, up to a
+** fixed capacity. Pushing into a full RingBuffer overwrites the oldest
+** element, so the memory is allocated once and never grows. The elements are
+** indexed from the oldest to the newest one.
+** Unlike the BoundedQueue it is not thread safe.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef RINGBUFFER_HPP
+#define RINGBUFFER_HPP
+
+#include <vector>
+
+template <typename T>
+class RingBuffer {
+
+public:
+
+    RingBuffer(size_t capacity) : elements(capacity > 0 ? capacity : 1), first(0), count(0) {}
+
+    /**
+     * Appends an element. If the buffer is full the oldest element is dropped.
+     *
+     * @param element to append.
+     */
+    void push(T element)
+    {
+        elements[(first + count) % elements.size()] = element;
+
+        if (count < elements.size()) count++;
+        else                         first = (first + 1) % elements.size();
+    }
+
+    /**
+     * Returns the element at index, 0 being the oldest element.
+     *
+     * @param  index of the element, smaller than size().
+     * @return the element.
+     */
+    T & operator[](size_t index)
+    {
+        return elements[(first + index) % elements.size()];
+    }
+
+    /**
+     * Drops all elements.
+     */
+    void clear()
+    {
+        first = 0;
+        count = 0;
+    }
+
+    size_t size()     { return count; }
+    size_t capacity() { return elements.size(); }
+
+private:
+
+    std::vector<T> elements;
+    size_t         first, count;
+};
+
+#endif //RINGBUFFER_HPP
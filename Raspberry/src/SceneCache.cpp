@@ -0,0 +1,127 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "SceneCache.hpp"
+#include "ObjectBox.hpp"
+
+/**
+ * Reads the difference threshold from the properties. The cache starts empty.
+ */
+SceneCache::SceneCache()
+{
+    Logger::debug("SceneCache Constructor");
+
+    Properties * properties = Properties::getInstance();
+    threshold         = properties->getFloatPropertyWithName("vp_scene_cache_threshold");
+    logging           = properties->getNumberPropertyWithName("frame_debugging_output") == 1;
+    valid             = false;
+    hits              = 0;
+    misses            = 0;
+    currentGeneration = 0;
+}
+
+/**
+ * Looks for the result of a frame that showed the same scene. On a miss the
+ * signature of the frame and the current generation are returned, they have
+ * to be passed to store() together with the result once it is known.
+ *
+ * @param  frame        the frame that is about to be analyzed.
+ * @param  searchRegion the part of the frame that is searched.
+ * @param  signature    is set to the signature of the frame.
+ * @param  generation   is set to the current generation of the cache.
+ * @return              a new ObjectBox with the cached result, marked as cached, NULL on a miss.
+ */
+ObjectBox * SceneCache::lookup(const cv::Mat & frame, cv::Rect searchRegion, cv::Mat & signature, long & generation)
+{
+    makeSignature(frame, signature);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    generation = currentGeneration;
+
+    if (valid && searchRegion == lastSearchRegion) {
+        double difference = cv::norm(signature, lastSignature, cv::NORM_L1) / signature.total();
+
+        if (difference <= threshold) {
+            hits++;
+            if (logging) printf("Scene unchanged (difference %.2f), reusing the last result: %ld hits, %ld misses\n", difference, hits, misses);
+            ObjectBox * cachedBox = new ObjectBox(lastCornerPoints, lastConfidence);
+            cachedBox->markCached();
+            return cachedBox;
+        }
+    }
+
+    misses++;
+    return NULL;
+}
+
+/**
+ * Remembers the result of an analyzed frame. Results of frames that were looked
+ * up before the cache was last invalidated are dropped, because the camera
+ * moved since they were captured.
+ *
+ * @param signature    the signature lookup() returned for the frame.
+ * @param searchRegion the part of the frame that was searched.
+ * @param generation   the generation lookup() returned for the frame.
+ * @param objectBox    the result of the analysis. It is only copied.
+ */
+void SceneCache::store(const cv::Mat & signature, cv::Rect searchRegion, long generation, ObjectBox * objectBox)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (generation != currentGeneration) return;
+
+    signature.copyTo(lastSignature);
+    lastSearchRegion = searchRegion;
+    lastCornerPoints = objectBox->getObjectCornerPoints();
+    lastConfidence   = objectBox->getConfidence();
+    valid            = true;
+}
+
+/**
+ * Forgets the last result. This has to be called whenever the camera moved.
+ */
+void SceneCache::invalidate()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    valid = false;
+    currentGeneration++;
+}
+
+/**
+ * Returns how often a result was reused.
+ *
+ * @return the number of hits.
+ */
+long SceneCache::getHits()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+/**
+ * Returns how often a frame had to be analyzed.
+ *
+ * @return the number of misses.
+ */
+long SceneCache::getMisses()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+// MARK: PRIVATE
+
+/**
+ * Shrinks a frame to the signature size and converts it to gray.
+ *
+ * @param frame     the frame.
+ * @param signature is set to the signature.
+ */
+void SceneCache::makeSignature(const cv::Mat & frame, cv::Mat & signature)
+{
+    cv::Mat smallFrame;
+    cv::resize(frame, smallFrame, cv::Size(SCENE_CACHE_SIGNATURE_WIDTH, SCENE_CACHE_SIGNATURE_HEIGHT), 0, 0, cv::INTER_AREA);
+
+    if (smallFrame.channels() == 1) signature = smallFrame;
+    else                            cv::cvtColor(smallFrame, signature, CV_BGRA2GRAY);
+}
@@ -0,0 +1,65 @@
+/*! \class SceneCache SceneCache.hpp "SceneCache.hpp"
+**
+** The SceneCache remembers the result of the last analyzed frame, so it can be
+** reused while the scene does not change. While the vehicle stands still, e.g.
+** between two steps or while the launcher waits to fire, the camera delivers
+** nearly identical frames and analyzing every one of them again is a waste.
+**
+** Every frame is reduced to a tiny gray signature. If it differs from the
+** signature of the last analyzed frame by less than the threshold (the mean
+** absolute difference in gray levels) and the same search region is searched,
+** the result of that frame is used again. The signature is not updated on a
+** hit, so a scene that changes slowly still causes a miss eventually.
+** Every motion of the vehicle or the launcher has to invalidate the cache.
+**
+** The cache is shared by all ObjectDetectors, so it can be used from several
+** threads at once.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef SCENECACHE_HPP
+#define SCENECACHE_HPP
+
+#include <stdio.h>
+#include <array>
+#include <mutex>
+#include <string>
+#include "opencv2/core/core.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include "Properties.hpp"
+#include "Logger.hpp"
+
+/** The size of the frame signatures in pixels. */
+#define SCENE_CACHE_SIGNATURE_WIDTH  32
+#define SCENE_CACHE_SIGNATURE_HEIGHT 24
+
+class ObjectBox;
+
+class SceneCache {
+
+public:
+
+    SceneCache();
+    ObjectBox * lookup(const cv::Mat & frame, cv::Rect searchRegion, cv::Mat & signature, long & generation);
+    void        store(const cv::Mat & signature, cv::Rect searchRegion, long generation, ObjectBox * objectBox);
+    void        invalidate();
+    long        getHits();
+    long        getMisses();
+
+private:
+
+    std::mutex                 mutex;
+    float                      threshold;
+    bool                       logging, valid;
+    long                       hits, misses, currentGeneration;
+    cv::Mat                    lastSignature;
+    cv::Rect                   lastSearchRegion;
+    std::array<cv::Point2f, 4> lastCornerPoints;
+    float                      lastConfidence;
+
+    void makeSignature(const cv::Mat & frame, cv::Mat & signature);
+};
+
+#endif //SCENECACHE_HPP
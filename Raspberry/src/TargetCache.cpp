@@ -0,0 +1,247 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "TargetCache.hpp"
+
+static const char TARGET_CACHE_MAGIC[8] = {'M', 'L', 'T', 'C', 'A', 'C', 'H', 'E'};
+
+/**
+ * The constructor only stores the path. Nothing is read until load() is called.
+ *
+ * @param cachePath path of the cache file.
+ */
+TargetCache::TargetCache(std::string cachePath)
+{
+    Logger::debug("TargetCache Constructor");
+    this->cachePath = cachePath;
+    mappedFile      = NULL;
+    mappedSize      = 0;
+}
+
+/**
+ * The destructor unmaps the cache file. Descriptors that were loaded from the
+ * cache are invalid afterwards.
+ */
+TargetCache::~TargetCache()
+{
+    unmap();
+}
+
+/**
+ * Maps the cache file into memory and reads the keypoints and descriptors from
+ * it if the key of the file matches the specified key. The descriptor matrix
+ * points into the mapped file and stays valid as long as this TargetCache
+ * exists.
+ *
+ * @param  key         the key the cache has to match.
+ * @param  keypoints   is set to the cached keypoints.
+ * @param  descriptors is set to the cached descriptors.
+ * @return             false if there is no cache file or if it is stale.
+ */
+bool TargetCache::load(uint64_t key, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors)
+{
+    unmap();
+
+    int fd = open(cachePath.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+
+    struct stat fileStatus;
+    if (fstat(fd, &fileStatus) != 0 || fileStatus.st_size < (off_t) sizeof(Header)) {
+        close(fd);
+        return false;
+    }
+
+    mappedSize = fileStatus.st_size;
+    mappedFile = mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mappedFile == MAP_FAILED) {
+        mappedFile = NULL;
+        mappedSize = 0;
+        return false;
+    }
+
+    const Header * header = (const Header *) mappedFile;
+    size_t keypointsSize   = header->keypointCount * sizeof(StoredKeyPoint);
+    size_t descriptorsSize = (size_t) header->descriptorRows * header->descriptorCols * CV_ELEM_SIZE(header->descriptorType);
+
+    bool valid = std::memcmp(header->magic, TARGET_CACHE_MAGIC, sizeof(header->magic)) == 0
+              && header->version == TARGET_CACHE_VERSION
+              && header->key     == key
+              && sizeof(Header) + keypointsSize <= header->descriptorOffset
+              && header->descriptorOffset + descriptorsSize <= mappedSize;
+
+    if (!valid) {
+        printf("TargetCache: %s is stale.\n", cachePath.c_str());
+        unmap();
+        return false;
+    }
+
+    const StoredKeyPoint * storedKeypoints = (const StoredKeyPoint *) ((const char *) mappedFile + sizeof(Header));
+    keypoints.clear();
+    keypoints.reserve(header->keypointCount);
+
+    for (uint32_t i = 0; i < header->keypointCount; i++) {
+        const StoredKeyPoint & k = storedKeypoints[i];
+        keypoints.push_back(cv::KeyPoint(k.x, k.y, k.size, k.angle, k.response, k.octave, k.classId));
+    }
+
+    void * descriptorData = (char *) mappedFile + header->descriptorOffset;
+    descriptors = cv::Mat(header->descriptorRows, header->descriptorCols, header->descriptorType, descriptorData);
+
+    printf("TargetCache: loaded %u keypoints from %s.\n", header->keypointCount, cachePath.c_str());
+    return true;
+}
+
+/**
+ * Writes the keypoints and descriptors to the cache file. The file is written
+ * to a temporary file first and then renamed, so a process that reads the
+ * cache at the same time never sees a half written file. Every writer gets a
+ * temporary file with a unique name, so processes that write the same cache
+ * at the same time do not write into each other's file.
+ *
+ * @param  key         the key to save with the cache.
+ * @param  keypoints   the keypoints to save.
+ * @param  descriptors the descriptors to save. Row i belongs to keypoint i.
+ * @return             whether the cache file was written.
+ */
+bool TargetCache::store(uint64_t key, const std::vector<cv::KeyPoint> & keypoints, const cv::Mat & descriptors)
+{
+    Header header;
+    std::memcpy(header.magic, TARGET_CACHE_MAGIC, sizeof(header.magic));
+    header.version        = TARGET_CACHE_VERSION;
+    header.keypointCount  = keypoints.size();
+    header.key            = key;
+    header.descriptorRows = descriptors.rows;
+    header.descriptorCols = descriptors.cols;
+    header.descriptorType = descriptors.type();
+
+    // the descriptors start 16 byte aligned so they can be read with SIMD instructions.
+    size_t keypointsEnd     = sizeof(Header) + keypoints.size() * sizeof(StoredKeyPoint);
+    header.descriptorOffset = (keypointsEnd + 15) & ~((size_t) 15);
+
+    std::string temporaryPath;
+    int fileDescriptor = createTemporaryFile(cachePath, temporaryPath);
+    if (fileDescriptor == -1) return false;
+
+    FILE * file = fdopen(fileDescriptor, "wb");
+    if (file == NULL) {
+        ::close(fileDescriptor);
+        unlink(temporaryPath.c_str());
+        return false;
+    }
+
+    bool success = fwrite(&header, sizeof(Header), 1, file) == 1;
+
+    for (int i = 0; success && i < keypoints.size(); i++) {
+        const cv::KeyPoint & k = keypoints[i];
+        StoredKeyPoint stored = {k.pt.x, k.pt.y, k.size, k.angle, k.response, k.octave, k.class_id};
+        success = fwrite(&stored, sizeof(StoredKeyPoint), 1, file) == 1;
+    }
+
+    char padding[16] = {0};
+    size_t paddingSize = header.descriptorOffset - keypointsEnd;
+    if (success && paddingSize > 0) success = fwrite(padding, paddingSize, 1, file) == 1;
+
+    size_t rowSize = descriptors.cols * descriptors.elemSize();
+    for (int i = 0; success && i < descriptors.rows; i++) {
+        success = fwrite(descriptors.ptr(i), rowSize, 1, file) == 1;
+    }
+
+    success = fclose(file) == 0 && success;
+
+    if (!success || rename(temporaryPath.c_str(), cachePath.c_str()) != 0) {
+        unlink(temporaryPath.c_str());
+        printf("TargetCache: could not write %s.\n", cachePath.c_str());
+        return false;
+    }
+
+    printf("TargetCache: wrote %zu keypoints to %s.\n", keypoints.size(), cachePath.c_str());
+    return true;
+}
+
+/**
+ * Getter for the path of the cache file.
+ *
+ * @return the cache path
+ */
+std::string TargetCache::getCachePath() { return cachePath; }
+
+/**
+ * Calculates a 64 bit FNV-1a hash.
+ *
+ * @param  data   the bytes to hash.
+ * @param  length number of bytes.
+ * @param  seed   the hash to continue from. Use 0 to start a new hash.
+ * @return        the hash.
+ */
+uint64_t TargetCache::hash(const void * data, size_t length, uint64_t seed)
+{
+    uint64_t result = seed == 0 ? 14695981039346656037ULL : seed;
+    const unsigned char * bytes = (const unsigned char *) data;
+
+    for (size_t i = 0; i < length; i++) {
+        result ^= bytes[i];
+        result *= 1099511628211ULL;
+    }
+
+    return result;
+}
+
+/**
+ * Calculates the cache key for an image and the settings that are used to
+ * describe it. Changing a single pixel or setting results in a different key.
+ *
+ * @param  image    the target image.
+ * @param  settings a string that describes the detector settings, e.g. "surf 500".
+ * @return          the key.
+ */
+uint64_t TargetCache::hashImage(const cv::Mat & image, std::string settings)
+{
+    int32_t dimensions[3] = {image.rows, image.cols, image.type()};
+    uint64_t result = hash(dimensions, sizeof(dimensions), 0);
+
+    for (int i = 0; i < image.rows; i++) {
+        result = hash(image.ptr(i), image.cols * image.elemSize(), result);
+    }
+
+    return hash(settings.c_str(), settings.length(), result);
+}
+
+/**
+ * Creates a temporary file with a unique name next to path, so it can be
+ * renamed to path once it is written completely. Like a file created by
+ * fopen() it can be read by everyone.
+ *
+ * @param  path          the path the file is renamed to later.
+ * @param  temporaryPath is set to the path of the temporary file.
+ * @return               the open file descriptor, -1 if the file could not be created.
+ */
+int TargetCache::createTemporaryFile(const std::string & path, std::string & temporaryPath)
+{
+    std::vector<char> pathTemplate(path.begin(), path.end());
+    const char        suffix[] = ".XXXXXX";
+    pathTemplate.insert(pathTemplate.end(), suffix, suffix + sizeof(suffix));
+
+    int fileDescriptor = mkstemp(pathTemplate.data());
+    if (fileDescriptor == -1) return -1;
+    fchmod(fileDescriptor, 0644);
+
+    temporaryPath = pathTemplate.data();
+    return fileDescriptor;
+}
+
+// MARK: PRIVATE
+
+/**
+ * Unmaps the cache file if it is mapped.
+ */
+void TargetCache::unmap()
+{
+    if (mappedFile != NULL) {
+        munmap(mappedFile, mappedSize);
+        mappedFile = NULL;
+        mappedSize = 0;
+    }
+}
@@ -0,0 +1,74 @@
+/*! \class TargetCache TargetCache.hpp "TargetCache.hpp"
+**
+** The TargetCache saves the keypoints and descriptors of the target image to a
+** file so they do not have to be calculated again every time the program
+** starts. The cache file is memory mapped when it is loaded, the descriptor
+** matrix points directly into the mapped file and is not copied.
+** Every cache file carries a key. The key is a hash of the target image and of
+** the settings that were used to describe it. If the key does not match the
+** cache is stale and has to be rebuilt.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef TARGETCACHE_HPP
+#define TARGETCACHE_HPP
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "opencv2/core/core.hpp"
+#include "opencv2/features2d/features2d.hpp"
+
+#include "Logger.hpp"
+
+/** Increase this whenever the layout of the cache file changes. */
+#define TARGET_CACHE_VERSION 1
+
+class TargetCache {
+
+public:
+
+    TargetCache(std::string cachePath);
+    ~TargetCache();
+    bool load(uint64_t key, std::vector<cv::KeyPoint> & keypoints, cv::Mat & descriptors);
+    bool store(uint64_t key, const std::vector<cv::KeyPoint> & keypoints, const cv::Mat & descriptors);
+    std::string getCachePath();
+
+    static uint64_t hash(const void * data, size_t length, uint64_t seed);
+    static uint64_t hashImage(const cv::Mat & image, std::string settings);
+    static int      createTemporaryFile(const std::string & path, std::string & temporaryPath);
+
+private:
+
+    struct Header {
+        char     magic[8];
+        uint32_t version;
+        uint32_t keypointCount;
+        uint64_t key;
+        int32_t  descriptorRows;
+        int32_t  descriptorCols;
+        int32_t  descriptorType;
+        uint32_t descriptorOffset;
+    };
+
+    struct StoredKeyPoint {
+        float   x, y, size, angle, response;
+        int32_t octave, classId;
+    };
+
+    std::string cachePath;
+    void *      mappedFile;
+    size_t      mappedSize;
+
+    void unmap();
+};
+
+#endif //TARGETCACHE_HPP
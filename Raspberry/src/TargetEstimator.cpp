@@ -0,0 +1,187 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "TargetEstimator.hpp"
+
+/**
+ * Sets up the Kalman filter. The state and the measurement both are the
+ * center x, center y and the relative area of the target. The only control
+ * input is the horizontal shift of the image caused by a turn.
+ */
+TargetEstimator::TargetEstimator()
+{
+    Logger::debug("TargetEstimator Constructor");
+
+    Properties * properties = Properties::getInstance();
+    processNoise         = properties->getFloatPropertyWithName("vp_estimator_process_noise");
+    turnNoise            = properties->getFloatPropertyWithName("vp_estimator_turn_noise");
+    areaNoise            = properties->getFloatPropertyWithName("vp_estimator_area_noise");
+    driveAreaNoise       = properties->getFloatPropertyWithName("vp_estimator_drive_area_noise");
+    measurementNoise     = properties->getFloatPropertyWithName("vp_estimator_measurement_noise");
+    measurementAreaNoise = properties->getFloatPropertyWithName("vp_estimator_measurement_area_noise");
+    maxCenterError       = properties->getFloatPropertyWithName("vp_estimator_max_center_error");
+    maxAreaError         = properties->getFloatPropertyWithName("vp_estimator_max_area_error");
+
+    filter.init(3, 3, 1, CV_32F);
+    cv::setIdentity(filter.transitionMatrix);
+    cv::setIdentity(filter.measurementMatrix);
+    filter.controlMatrix = cv::Mat::zeros(3, 1, CV_32F);
+    filter.controlMatrix.at<float>(0, 0) = 1;
+
+    reset();
+}
+
+/**
+ * Moves the estimate by the motion the vehicle was commanded to do since the
+ * last prediction and makes it less certain.
+ *
+ * @param pixelShift how many pixels the image is expected to have moved to the right.
+ * @param driveTime  how long the vehicle drove forward or backward in milliseconds.
+ */
+void TargetEstimator::predict(int pixelShift, int driveTime)
+{
+    if (!initialized) return;
+
+    float centerNoise = processNoise * processNoise;
+    float shiftNoise  = turnNoise * pixelShift;
+    float driveNoise  = driveAreaNoise * std::abs(driveTime) / 1000.0;
+
+    filter.processNoiseCov = cv::Mat::zeros(3, 3, CV_32F);
+    filter.processNoiseCov.at<float>(0, 0) = centerNoise + shiftNoise * shiftNoise;
+    filter.processNoiseCov.at<float>(1, 1) = centerNoise;
+    filter.processNoiseCov.at<float>(2, 2) = areaNoise * areaNoise + driveNoise * driveNoise;
+
+    cv::Mat control = cv::Mat::zeros(1, 1, CV_32F);
+    control.at<float>(0, 0) = pixelShift;
+
+    filter.predict(control);
+    predicted = true;
+}
+
+/**
+ * Corrects the estimate with a detected ObjectBox. The lower its confidence
+ * the less it is trusted. The first box after a reset becomes the estimate.
+ * If there was no prediction since the last correction, one without any
+ * motion is made first.
+ *
+ * @param objectBox the detected ObjectBox.
+ */
+void TargetEstimator::correct(ObjectBox & objectBox)
+{
+    cv::Mat measurement = measurementOf(objectBox);
+    float   confidence  = std::max(objectBox.getConfidence(), 0.1f);
+
+    filter.measurementNoiseCov = cv::Mat::zeros(3, 3, CV_32F);
+    filter.measurementNoiseCov.at<float>(0, 0) = measurementNoise * measurementNoise / confidence;
+    filter.measurementNoiseCov.at<float>(1, 1) = measurementNoise * measurementNoise / confidence;
+    filter.measurementNoiseCov.at<float>(2, 2) = measurementAreaNoise * measurementAreaNoise / confidence;
+
+    if (initialized) {
+        if (!predicted) predict(0, 0);
+        filter.correct(measurement);
+    } else {
+        measurement.copyTo(filter.statePre);
+        measurement.copyTo(filter.statePost);
+        filter.measurementNoiseCov.copyTo(filter.errorCovPre);
+        filter.measurementNoiseCov.copyTo(filter.errorCovPost);
+        initialized = true;
+    }
+    predicted = false;
+
+    lastObjectBox = objectBox;
+}
+
+/**
+ * Forgets the estimate, e.g. because the target was lost or the camera moved
+ * in an unknown way.
+ */
+void TargetEstimator::reset()
+{
+    initialized         = false;
+    predicted           = false;
+    filter.statePre     = cv::Mat::zeros(3, 1, CV_32F);
+    filter.statePost    = cv::Mat::zeros(3, 1, CV_32F);
+    filter.errorCovPre  = cv::Mat::zeros(3, 3, CV_32F);
+    filter.errorCovPost = cv::Mat::zeros(3, 3, CV_32F);
+}
+
+/**
+ * Returns whether the estimate is certain enough to be used instead of a
+ * detection. This is the case if the standard deviation of the center and of
+ * the area are below their limits.
+ *
+ * @return true if the estimate can be used.
+ */
+bool TargetEstimator::isReliable()
+{
+    if (!initialized) return false;
+
+    float centerError = std::sqrt(std::max(errorCov().at<float>(0, 0), errorCov().at<float>(1, 1)));
+    float areaError   = std::sqrt(errorCov().at<float>(2, 2));
+
+    return centerError <= maxCenterError && areaError <= maxAreaError;
+}
+
+/**
+ * Returns the last detected ObjectBox moved to the estimated center and scaled
+ * to the estimated area.
+ *
+ * @return the predicted ObjectBox.
+ */
+ObjectBox TargetEstimator::predictedObjectBox()
+{
+    cv::Point2f lastCenter = lastObjectBox.getObjectCenter();
+    float       lastArea   = lastObjectBox.getRelativeObjectArea();
+
+    cv::Point2f center = cv::Point2f(state().at<float>(0, 0), state().at<float>(1, 0));
+    float       area   = state().at<float>(2, 0);
+    float       scale  = lastArea > 0 && area > 0 ? std::sqrt(area / lastArea) : 1;
+
+    std::array<cv::Point2f, 4> corners = lastObjectBox.getObjectCornerPoints();
+    for (int i = 0; i < 4; i++) {
+        corners[i] = center + (corners[i] - lastCenter) * scale;
+    }
+
+    return ObjectBox(corners, lastObjectBox.getConfidence());
+}
+
+// MARK: PRIVATE
+
+/**
+ * Turns an ObjectBox into a measurement of the filter.
+ *
+ * @param  objectBox the detected ObjectBox.
+ * @return           the center x, center y and relative area as a column vector.
+ */
+cv::Mat TargetEstimator::measurementOf(ObjectBox & objectBox)
+{
+    cv::Mat measurement = cv::Mat::zeros(3, 1, CV_32F);
+    measurement.at<float>(0, 0) = objectBox.getObjectCenter().x;
+    measurement.at<float>(1, 0) = objectBox.getObjectCenter().y;
+    measurement.at<float>(2, 0) = objectBox.getRelativeObjectArea();
+    return measurement;
+}
+
+/**
+ * Returns the current estimate. After a prediction that is the predicted
+ * state, otherwise the corrected one.
+ *
+ * @return the center x, center y and relative area as a column vector.
+ */
+const cv::Mat & TargetEstimator::state()
+{
+    return predicted ? filter.statePre : filter.statePost;
+}
+
+/**
+ * Returns the uncertainty of the current estimate. KalmanFilter::predict()
+ * only updates errorCovPre, so after a prediction that is the one that holds
+ * the uncertainty the motion added.
+ *
+ * @return the error covariance of the estimate.
+ */
+const cv::Mat & TargetEstimator::errorCov()
+{
+    return predicted ? filter.errorCovPre : filter.errorCovPost;
+}
@@ -0,0 +1,63 @@
+/*! \class TargetEstimator TargetEstimator.hpp "TargetEstimator.hpp"
+**
+** The TargetEstimator keeps an estimate of where the target is in the camera
+** image, so the Brain can keep deciding right after the vehicle moved instead
+** of waiting for the camera to settle and taking new samples.
+**
+** It is a Kalman filter on the center and the relative area of the ObjectBox.
+** The target itself does not move, so the estimate only changes because of the
+** vehicle: the commanded turns are the control input and shift the center by
+** the number of pixels the turn calibration (vehicle_turn_*_slope/intersect)
+** predicts. Driving forward or backward changes the area by an amount that is
+** not calibrated, so it only makes the area less certain. Every detected
+** ObjectBox corrects the estimate, weighted by its confidence.
+**
+** As long as the estimate is certain enough a predicted ObjectBox can be used
+** instead of a detected one. It is the last detected box moved to the estimated
+** center and scaled to the estimated area.
+** Every correction follows a prediction. If nothing moved since the last
+** correction a prediction without control input is made first, so repeated
+** detections of a standing vehicle keep the process noise in the estimate.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef TARGETESTIMATOR_HPP
+#define TARGETESTIMATOR_HPP
+
+#include <array>
+#include <cmath>
+#include "opencv2/core/core.hpp"
+#include "opencv2/video/tracking.hpp"
+
+#include "ObjectBox.hpp"
+#include "Properties.hpp"
+#include "Logger.hpp"
+
+class TargetEstimator {
+
+public:
+
+    TargetEstimator();
+    void      predict(int pixelShift, int driveTime);
+    void      correct(ObjectBox & objectBox);
+    void      reset();
+    bool      isReliable();
+    ObjectBox predictedObjectBox();
+
+private:
+
+    cv::KalmanFilter filter;
+    bool             initialized, predicted;
+    ObjectBox        lastObjectBox;
+
+    float processNoise, turnNoise, areaNoise, driveAreaNoise;
+    float measurementNoise, measurementAreaNoise;
+    float maxCenterError, maxAreaError;
+
+    cv::Mat         measurementOf(ObjectBox & objectBox);
+    const cv::Mat & state();
+    const cv::Mat & errorCov();
+};
+
+#endif //TARGETESTIMATOR_HPP
@@ -0,0 +1,142 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "TargetLibrary.hpp"
+
+/**
+ * Creates a TargetModel for every target image. Target i caches its keypoints
+ * and descriptors in cachePath with ".i" appended.
+ *
+ * @param targetImagePaths the images of the targets.
+ * @param cachePath        the base path of the target caches.
+ * @param featureSettings  the settings all targets and frames are described with.
+ */
+TargetLibrary::TargetLibrary(std::vector<std::string> targetImagePaths, std::string cachePath, FeatureSettings featureSettings)
+{
+    Logger::debug("TargetLibrary Constructor");
+    this->featureSettings = featureSettings;
+
+    for (int i = 0; i < targetImagePaths.size(); i++) {
+        targets.push_back(new TargetModel(targetImagePaths[i], cachePath + "." + std::to_string(i), featureSettings));
+    }
+}
+
+/**
+ * Sets up every target and stacks their descriptors into the combined
+ * descriptor matrix. It is safe to call from multiple threads, the work is
+ * only done once. If it fails, the next call tries again.
+ */
+void TargetLibrary::setUp()
+{
+    std::call_once(setUpFlag, [this] {
+
+        std::vector<int> targetRows, keypointRows;
+        cv::Mat          descriptors;
+
+        for (int t = 0; t < targets.size(); t++) {
+            targets[t]->setUpSURFandFLANN();
+
+            const cv::Mat & targetDescriptors = targets[t]->getObjectDescriptors();
+            if (targetDescriptors.empty()) continue;
+
+            descriptors.push_back(targetDescriptors);
+            for (int k = 0; k < targetDescriptors.rows; k++) {
+                targetRows.push_back(t);
+                keypointRows.push_back(k);
+            }
+        }
+
+        combinedDescriptors = descriptors;
+        entryTargets        = targetRows;
+        entryKeypoints      = keypointRows;
+    });
+}
+
+/**
+ * Builds an index over the combined descriptors of all targets. Binary
+ * descriptors are indexed with LSH and searched by their Hamming distance.
+ * setUp() has to be called before.
+ *
+ * @param index the index to set up.
+ */
+void TargetLibrary::loadCombinedIndex(cv::flann::Index & index)
+{
+    std::lock_guard<std::mutex> lock(indexMutex);
+
+    if (binaryDescriptors()) index.build(combinedDescriptors, cv::flann::LshIndexParams(12, 20, 2), cvflann::FLANN_DIST_HAMMING);
+    else                     index.build(combinedDescriptors, cv::flann::KDTreeIndexParams(4));
+}
+
+// MARK: Getter
+
+/**
+ * Returns the number of targets in the library.
+ *
+ * @return target count
+ */
+int TargetLibrary::targetCount() { return targets.size(); }
+
+/**
+ * Getter for the TargetModel of a target.
+ *
+ * @param  target the index of the target.
+ * @return        the TargetModel
+ */
+TargetModel * TargetLibrary::getTarget(int target) { return targets[target]; }
+
+/**
+ * Getter for the descriptors of all targets. Row i belongs to the target
+ * getEntryTargets()[i].
+ *
+ * @return the combined descriptors
+ */
+const cv::Mat & TargetLibrary::getCombinedDescriptors() { return combinedDescriptors; }
+
+/**
+ * Returns which target every row of the combined descriptors belongs to.
+ *
+ * @return the index of the target of every row.
+ */
+const std::vector<int> & TargetLibrary::getEntryTargets() { return entryTargets; }
+
+/**
+ * Returns which keypoint of its target every row of the combined descriptors describes.
+ *
+ * @return the index of the keypoint within the target of every row.
+ */
+const std::vector<int> & TargetLibrary::getEntryKeypoints() { return entryKeypoints; }
+
+/**
+ * Getter for the settings the targets are described with. Frames have to be
+ * analyzed with the same settings.
+ *
+ * @return the feature settings
+ */
+FeatureSettings TargetLibrary::getFeatureSettings() { return featureSettings; }
+
+/**
+ * Returns whether the descriptors are binary and have to be compared by their
+ * Hamming distance.
+ *
+ * @return true if the descriptors are binary
+ */
+bool TargetLibrary::binaryDescriptors() { return targets.empty() ? false : targets[0]->binaryDescriptors(); }
+
+/**
+ * Splits the comma separated list of target images from the properties file.
+ *
+ * @param  list the list.
+ * @return      the paths, empty if the list is empty.
+ */
+std::vector<std::string> TargetLibrary::splitPaths(std::string list)
+{
+    std::vector<std::string> paths;
+    std::stringstream        stream(list);
+    std::string              path;
+
+    while (std::getline(stream, path, ',')) {
+        if (!path.empty()) paths.push_back(path);
+    }
+    return paths;
+}
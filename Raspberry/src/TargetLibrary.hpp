@@ -0,0 +1,63 @@
+/*! \class TargetLibrary TargetLibrary.hpp "TargetLibrary.hpp"
+**
+** The TargetLibrary holds a TargetModel for every target the launcher can
+** engage. All of them are described with the same FeatureSettings, so their
+** descriptors can be stacked into one combined descriptor matrix. Every row
+** of it is tagged with the target it belongs to and the keypoint it describes
+** within that target. A single index over the combined descriptors is enough
+** to match a frame against all targets at once: every scene descriptor is
+** looked up once, no matter how many targets there are.
+** Like the TargetModels the library is shared read-only, every caller gets its
+** own copy of the index.
+** The targets of a library that is used with a VocabularyTree are not set up
+** by setUp() but one by one, once the vocabulary shortlists them.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef TARGETLIBRARY_HPP
+#define TARGETLIBRARY_HPP
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <sstream>
+#include "opencv2/core/core.hpp"
+#include "opencv2/flann/flann.hpp"
+
+#include "TargetModel.hpp"
+#include "FeatureBackend.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+class TargetLibrary {
+
+public:
+
+    TargetLibrary(std::vector<std::string> targetImagePaths, std::string cachePath, FeatureSettings featureSettings);
+    void setUp();
+    void loadCombinedIndex(cv::flann::Index & index);
+
+    // MARK: Getter
+    int                targetCount();
+    TargetModel *      getTarget(int target);
+    const cv::Mat &    getCombinedDescriptors();
+    const std::vector<int> & getEntryTargets();
+    const std::vector<int> & getEntryKeypoints();
+    FeatureSettings    getFeatureSettings();
+    bool               binaryDescriptors();
+
+    static std::vector<std::string> splitPaths(std::string list);
+
+private:
+
+    std::vector<TargetModel *> targets;
+    FeatureSettings            featureSettings;
+    std::once_flag             setUpFlag;
+    std::mutex                 indexMutex;
+
+    cv::Mat          combinedDescriptors;
+    std::vector<int> entryTargets, entryKeypoints;
+};
+
+#endif //TARGETLIBRARY_HPP
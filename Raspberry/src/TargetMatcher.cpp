@@ -0,0 +1,194 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "TargetMatcher.hpp"
+
+/**
+ * The constructor only stores the settings. The target index is built the
+ * first time it is needed because the TargetModel might not be set up yet.
+ * Whether the descriptors are binary is already known from its settings.
+ *
+ * @param targetModel the target to match against.
+ * @param type        how the descriptors are matched.
+ * @param ratio       the ratio for Lowe's ratio test.
+ */
+TargetMatcher::TargetMatcher(TargetModel * targetModel, matcherType type, float ratio)
+{
+    Logger::debug("TargetMatcher Constructor");
+    this->targetModel = targetModel;
+    this->type        = type;
+    this->ratio       = ratio;
+    binary            = targetModel->binaryDescriptors();
+    targetIndexReady  = false;
+    candidateCount    = 0;
+
+    if (binary) sceneMatcher = new cv::FlannBasedMatcher(new cv::flann::LshIndexParams(12, 20, 2));
+    else        sceneMatcher = new cv::FlannBasedMatcher();
+}
+
+/**
+ * Matches the scene descriptors of a frame against the target descriptors and
+ * returns the matches that are good enough to localize the target with.
+ *
+ * @param sceneDescriptors the descriptors of the scene keypoints.
+ * @param goodMatches      is set to the good matches.
+ */
+void TargetMatcher::match(const cv::Mat & sceneDescriptors, std::vector<cv::DMatch> & goodMatches)
+{
+    findCandidates(sceneDescriptors);
+    filterCandidates(goodMatches);
+}
+
+/**
+ * The first half of match(). Searches the closest target descriptors of the
+ * scene descriptors (or the other way around for flannScene) and keeps them
+ * as candidates. Only the benchmark calls this on its own to time the search
+ * separately from the filtering.
+ *
+ * @param sceneDescriptors the descriptors of the scene keypoints.
+ */
+void TargetMatcher::findCandidates(const cv::Mat & sceneDescriptors)
+{
+    candidateCount = 0;
+
+    switch (type) {
+        case flannScene  : searchSceneIndex(sceneDescriptors); break;
+        case flannTarget : searchTargetIndex(sceneDescriptors); break;
+        case bruteForce  : searchBruteForce(sceneDescriptors); break;
+    }
+}
+
+/**
+ * The second half of match(). Keeps the candidates of the last
+ * findCandidates() call that are good enough to localize the target with.
+ *
+ * @param goodMatches is set to the good matches.
+ */
+void TargetMatcher::filterCandidates(std::vector<cv::DMatch> & goodMatches)
+{
+    goodMatches = std::vector< cv::DMatch >{};
+    if (candidateCount == 0) return;
+
+    if (type == flannScene) applyDistanceFilter(goodMatches);
+    else                    applyRatioTest(goodMatches);
+}
+
+/**
+ * Translates the name of a matcher from the properties file into a matcherType.
+ *
+ * @param  name the name of the matcher.
+ * @return      the matcherType
+ */
+TargetMatcher::matcherType TargetMatcher::matcherTypeWithName(std::string name)
+{
+    if (name == "flann_scene")  return matcherType::flannScene;
+    if (name == "flann_target") return matcherType::flannTarget;
+    if (name == "brute_force")  return matcherType::bruteForce;
+
+    throw InvalidPropertyException("vp_matcher", name);
+}
+
+// MARK: PRIVATE
+
+/**
+ * Matches every target descriptor against an index over the scene descriptors.
+ * The FLANN matcher has to build this index again for every frame.
+ *
+ * @param sceneDescriptors the descriptors of the scene keypoints.
+ */
+void TargetMatcher::searchSceneIndex(const cv::Mat & sceneDescriptors)
+{
+    const cv::Mat & objectDescriptors = targetModel->getObjectDescriptors();
+
+    matches = std::vector< cv::DMatch >{};
+    sceneMatcher->match( objectDescriptors, sceneDescriptors, matches );
+    candidateCount = matches.size();
+}
+
+/**
+ * Looks up every scene descriptor in the index over the target descriptors.
+ * The index is only built once. For every scene descriptor the two closest
+ * target descriptors are searched for the ratio test.
+ *
+ * @param sceneDescriptors the descriptors of the scene keypoints.
+ */
+void TargetMatcher::searchTargetIndex(const cv::Mat & sceneDescriptors)
+{
+    if (sceneDescriptors.empty() || targetModel->getObjectDescriptors().rows < 2) return;
+
+    if (!targetIndexReady) {
+        targetModel->loadTargetIndex(targetIndex);
+        targetIndexReady = true;
+    }
+
+    targetIndex.knnSearch(sceneDescriptors, indices, distances, 2, cv::flann::SearchParams(32));
+    candidateCount = sceneDescriptors.rows;
+}
+
+/**
+ * Compares every scene descriptor with every target descriptor to find the
+ * two closest target descriptors for the ratio test. Unlike the FLANN index
+ * this always finds the exact neighbours.
+ *
+ * @param sceneDescriptors the descriptors of the scene keypoints.
+ */
+void TargetMatcher::searchBruteForce(const cv::Mat & sceneDescriptors)
+{
+    if (sceneDescriptors.empty() || targetModel->getObjectDescriptors().rows < 2) return;
+
+    bruteForceMatcher.findTwoNearest(sceneDescriptors, targetModel->getObjectDescriptors(), indices, distances);
+    candidateCount = sceneDescriptors.rows;
+}
+
+/**
+ * Keeps the matches of the scene index that are closer than three times the
+ * closest match.
+ *
+ * @param goodMatches the good matches are appended to this vector.
+ */
+void TargetMatcher::applyDistanceFilter(std::vector<cv::DMatch> & goodMatches)
+{
+    maxDistance = 0;
+    minDistance = 100;
+
+    // Quick calculation of max and min distances between keypoints
+    for( int i = 0; i < matches.size(); i++ ) {
+        double distance = matches[i].distance;
+        if( distance < minDistance ) minDistance = distance;
+        if( distance > maxDistance ) maxDistance = distance;
+    }
+
+    for( int i = 0; i < matches.size(); i++ ) {
+        if( matches[i].distance < 3*minDistance ) {
+            goodMatches.push_back( matches[i]); }
+    }
+}
+
+/**
+ * Lowe's ratio test on the two closest target descriptors in indices and
+ * distances. The match is good if the closest one is closer than ratio times
+ * the distance of the second closest one. L2 distances are squared, that is
+ * why the ratio is squared as well. Hamming distances are used as they are.
+ * Neighbours LSH did not find have the index -1 and are skipped.
+ *
+ * @param goodMatches the good matches are appended to this vector.
+ */
+void TargetMatcher::applyRatioTest(std::vector<cv::DMatch> & goodMatches)
+{
+    // FLANN returns Hamming distances as integers.
+    if (distances.type() != CV_32F) distances.convertTo(distances, CV_32F);
+
+    float distanceRatio = binary ? ratio : ratio * ratio;
+
+    for (int i = 0; i < candidateCount; i++) {
+
+        if (indices.at<int>(i, 0) < 0 || indices.at<int>(i, 1) < 0) continue;
+
+        float closest = distances.at<float>(i, 0), secondClosest = distances.at<float>(i, 1);
+
+        if (closest < distanceRatio * secondClosest) {
+            goodMatches.push_back(cv::DMatch(indices.at<int>(i, 0), i, binary ? closest : std::sqrt(closest)));
+        }
+    }
+}
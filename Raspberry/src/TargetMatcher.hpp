@@ -0,0 +1,87 @@
+/*! \class TargetMatcher TargetMatcher.hpp "TargetMatcher.hpp"
+**
+** The TargetMatcher finds the scene keypoints that correspond to the keypoints
+** of the target. It supports different ways of matching descriptors:
+**
+** -flannScene builds a FLANN index over the scene descriptors of every frame
+** and looks up every target descriptor in it. Good matches are the ones that
+** are closer than three times the closest match.
+**
+** -flannTarget builds a FLANN index over the target descriptors only once and
+** looks up every scene descriptor in it. A match is only accepted if it passes
+** Lowe's ratio test, i.e. if the best match is clearly better than the second
+** best one.
+**
+** -bruteForce compares every scene descriptor with every target descriptor
+** using the SIMD kernels of the BruteForceMatcher. It finds the exact two
+** closest target descriptors and applies the same ratio test as flannTarget.
+**
+** Binary descriptors are compared by their Hamming distance. The FLANN
+** matchers use an LSH index for them instead of KD-trees.
+**
+** The matches are always returned with the target keypoint as queryIdx and
+** the scene keypoint as trainIdx.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef TARGETMATCHER_HPP
+#define TARGETMATCHER_HPP
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "opencv2/core/core.hpp"
+#include "opencv2/features2d/features2d.hpp"
+#include "opencv2/flann/flann.hpp"
+
+#include "TargetModel.hpp"
+#include "BruteForceMatcher.hpp"
+#include "Logger.hpp"
+
+class TargetMatcher {
+
+public:
+
+    enum matcherType {
+        flannScene,
+        flannTarget,
+        bruteForce
+    };
+
+    TargetMatcher(TargetModel * targetModel, matcherType type, float ratio);
+    void match(const cv::Mat & sceneDescriptors, std::vector<cv::DMatch> & goodMatches);
+    void findCandidates(const cv::Mat & sceneDescriptors);
+    void filterCandidates(std::vector<cv::DMatch> & goodMatches);
+
+    static matcherType matcherTypeWithName(std::string name);
+
+private:
+
+    TargetModel * targetModel;
+    matcherType   type;
+    float         ratio;
+    bool          binary;
+    int           candidateCount;
+
+    // flannScene
+    cv::Ptr<cv::FlannBasedMatcher> sceneMatcher;
+    std::vector<cv::DMatch> matches;
+    double                  maxDistance, minDistance;
+
+    // flannTarget
+    cv::flann::Index targetIndex;
+    bool             targetIndexReady;
+    cv::Mat          indices, distances;
+
+    // bruteForce
+    BruteForceMatcher bruteForceMatcher;
+
+    void searchSceneIndex(const cv::Mat & sceneDescriptors);
+    void searchTargetIndex(const cv::Mat & sceneDescriptors);
+    void searchBruteForce(const cv::Mat & sceneDescriptors);
+    void applyDistanceFilter(std::vector<cv::DMatch> & goodMatches);
+    void applyRatioTest(std::vector<cv::DMatch> & goodMatches);
+};
+
+#endif //TARGETMATCHER_HPP
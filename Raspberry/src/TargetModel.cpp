@@ -0,0 +1,165 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "TargetModel.hpp"
+
+/**
+ * The constructor only remembers where the target image is. The image is not
+ * read and the keypoints and descriptors are not calculated until
+ * setUpSURFandFLANN() is called, so a large TargetLibrary does not have to
+ * read every image at start up.
+ *
+ * @param targetImagePath path to the image of the target object.
+ * @param cachePath       path of the file the keypoints and descriptors are cached in.
+ * @param featureSettings the settings of the backend that calculates the descriptors.
+ */
+TargetModel::TargetModel(std::string targetImagePath, std::string cachePath, FeatureSettings featureSettings)
+    : featureBackend(featureSettings), cache(cachePath)
+{
+    Logger::debug("TargetModel Constructor");
+    this->targetImagePath = targetImagePath;
+    this->featureSettings = featureSettings;
+}
+
+/**
+ * This method sets up surf and flann properties that only have to be calculated
+ * once. If the cache holds keypoints and descriptors for the same image and
+ * settings they are taken from there. Otherwise they are calculated and the
+ * cache is rebuilt.
+ * It is safe to call it from multiple threads at the same time, the
+ * calculation is only done once. If it fails, the next call tries again.
+ */
+void TargetModel::setUpSURFandFLANN()
+{
+    std::call_once(setUpFlag, [this] {
+
+        targetImage = cv::imread(targetImagePath, CV_LOAD_IMAGE_GRAYSCALE);
+        if( !targetImage.data )  throw FileNotFoundException(targetImagePath);
+
+        uint64_t key = cacheKey();
+        if (cache.load(key, targetKeypoints, objectDescriptors)) return;
+
+        featureBackend.detectAndCompute( targetImage, targetKeypoints, objectDescriptors );
+        if (objectDescriptors.empty()) std::cout << "object discriptor empty" << std::endl;
+
+        cache.store(key, targetKeypoints, objectDescriptors);
+    });
+}
+
+/**
+ * Sets up a FLANN index over the target descriptors. The index is loaded from
+ * the file next to the cache if there is one for these descriptors. Otherwise
+ * it is built and saved so the next call (or the next start of the program)
+ * can load it. The file name contains a hash of the descriptors and the index
+ * parameters, so an index is never loaded for other descriptors. It is written
+ * to a temporary file first and then renamed, so an interrupted run does not
+ * leave a broken index behind.
+ * Every caller gets its own index so it can be searched without any locking.
+ * Binary descriptors are indexed with LSH and searched by their Hamming
+ * distance. setUpSURFandFLANN() has to be called before.
+ *
+ * @param index the index to set up.
+ */
+void TargetModel::loadTargetIndex(cv::flann::Index & index)
+{
+    std::lock_guard<std::mutex> lock(indexMutex);
+
+    std::string indexParameters = binaryDescriptors() ? "lsh 12 20 2" : "kdtree 4";
+    std::string indexCachePath  = indexPath(indexParameters);
+
+    try {
+        if (index.load(objectDescriptors, indexCachePath)) return;
+    }
+    catch (std::exception &e) {
+        std::cout << "Could not load target index " << indexCachePath << std::endl;
+    }
+
+    if (binaryDescriptors()) index.build(objectDescriptors, cv::flann::LshIndexParams(12, 20, 2), cvflann::FLANN_DIST_HAMMING);
+    else                     index.build(objectDescriptors, cv::flann::KDTreeIndexParams(4));
+
+    std::string temporaryPath;
+    int fileDescriptor = TargetCache::createTemporaryFile(indexCachePath, temporaryPath);
+    if (fileDescriptor == -1) {
+        std::cout << "Could not save target index " << indexCachePath << std::endl;
+        return;
+    }
+    ::close(fileDescriptor);
+
+    try {
+        index.save(temporaryPath);
+        if (rename(temporaryPath.c_str(), indexCachePath.c_str()) != 0) throw std::runtime_error("rename failed");
+    }
+    catch (std::exception &e) {
+        unlink(temporaryPath.c_str());
+        std::cout << "Could not save target index " << indexCachePath << std::endl;
+    }
+}
+
+// MARK: Getter
+
+/**
+ * Getter for the grayscale target image. It is read by setUpSURFandFLANN().
+ *
+ * @return the target image
+ */
+const cv::Mat & TargetModel::getTargetImage() { return targetImage; }
+
+/**
+ * Getter for the keypoints that were detected on the target image.
+ *
+ * @return the target keypoints
+ */
+const std::vector<cv::KeyPoint> & TargetModel::getTargetKeypoints() { return targetKeypoints; }
+
+/**
+ * Getter for the descriptors of the target keypoints. Row i describes keypoint i.
+ *
+ * @return the target descriptors
+ */
+const cv::Mat & TargetModel::getObjectDescriptors() { return objectDescriptors; }
+
+/**
+ * Getter for the settings the descriptors are calculated with. Frames have to
+ * be analyzed with the same settings.
+ *
+ * @return the feature settings
+ */
+FeatureSettings TargetModel::getFeatureSettings() { return featureSettings; }
+
+/**
+ * Returns whether the descriptors are binary and have to be compared by their
+ * Hamming distance.
+ *
+ * @return true if the descriptors are binary
+ */
+bool TargetModel::binaryDescriptors() { return featureBackend.binaryDescriptors(); }
+
+// MARK: PRIVATE
+
+/**
+ * Calculates the key of the cache. It depends on the pixels of the target image
+ * and on every setting that changes the keypoints or descriptors.
+ *
+ * @return the cache key
+ */
+uint64_t TargetModel::cacheKey()
+{
+    return TargetCache::hashImage(targetImage, featureBackend.description());
+}
+
+/**
+ * Returns the path of the file the FLANN index is saved in. It is next to the
+ * cache file and named after a hash of the descriptors and the index
+ * parameters.
+ *
+ * @param  indexParameters a string that describes the index, e.g. "kdtree 4".
+ * @return                 the path of the index file.
+ */
+std::string TargetModel::indexPath(std::string indexParameters)
+{
+    char key[17];
+    snprintf(key, sizeof(key), "%016llx", (unsigned long long) TargetCache::hashImage(objectDescriptors, indexParameters));
+
+    return cache.getCachePath() + "." + key + ".flann";
+}
@@ -0,0 +1,68 @@
+/*! \class TargetModel TargetModel.hpp "TargetModel.hpp"
+**
+** The TargetModel holds everything that is known about the target object
+** before the first frame is analyzed: the target image, its keypoints and
+** their descriptors. They are calculated by the FeatureBackend that is selected
+** in the FeatureSettings, the frames have to be analyzed with the same settings. These only have to be calculated once and are never
+** changed afterwards, which is why a single TargetModel can be shared by all
+** the ObjectDetectors that analyze frames in parallel.
+** The keypoints and descriptors are saved in a TargetCache so the next start of
+** the program can read them instead of calculating them again. The same goes
+** for the FLANN index over the target descriptors, which is saved next to the
+** cache file under a name that depends on the descriptors.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef TARGETMODEL_HPP
+#define TARGETMODEL_HPP
+
+#include <iostream>
+#include <string>
+#include <mutex>
+#include <stdexcept>
+#include <unistd.h>
+#include "opencv2/opencv.hpp"
+#include "opencv2/core/core.hpp"
+#include "opencv2/features2d/features2d.hpp"
+#include <opencv2/nonfree/features2d.hpp>
+#include "opencv2/highgui/highgui.hpp"
+#include "opencv2/flann/flann.hpp"
+
+#include "TargetCache.hpp"
+#include "FeatureBackend.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+class TargetModel {
+
+public:
+
+    TargetModel(std::string targetImagePath, std::string cachePath, FeatureSettings featureSettings);
+    void setUpSURFandFLANN();
+    void loadTargetIndex(cv::flann::Index & index);
+
+    // MARK: Getter
+    const cv::Mat &                   getTargetImage();
+    const std::vector<cv::KeyPoint> & getTargetKeypoints();
+    const cv::Mat &                   getObjectDescriptors();
+    FeatureSettings                   getFeatureSettings();
+    bool                              binaryDescriptors();
+
+private:
+
+    std::string targetImagePath;
+    FeatureSettings featureSettings;
+    FeatureBackend  featureBackend;
+    std::once_flag setUpFlag;
+    TargetCache    cache;
+    std::mutex     indexMutex;
+
+    cv::Mat                   targetImage, objectDescriptors;
+    std::vector<cv::KeyPoint> targetKeypoints;
+
+    uint64_t    cacheKey();
+    std::string indexPath(std::string indexParameters);
+};
+
+#endif //TARGETMODEL_HPP
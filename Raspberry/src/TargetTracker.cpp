@@ -0,0 +1,177 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "TargetTracker.hpp"
+#include "ObjectBox.hpp"
+
+/**
+ * The constructor only stores the settings. The first frame is always analyzed
+ * by the ObjectDetector.
+ *
+ * @param targetModel       the target that is tracked.
+ * @param objectDetector    the detector for the full detections.
+ * @param detectionInterval every how many frames a full detection is run.
+ */
+TargetTracker::TargetTracker(TargetModel * targetModel, ObjectDetector * objectDetector, int detectionInterval)
+{
+    Logger::debug("TargetTracker Constructor");
+    this->targetModel       = targetModel;
+    this->objectDetector    = objectDetector;
+    this->detectionInterval = std::max(1, detectionInterval);
+    tracked                 = false;
+    reset();
+}
+
+/**
+ * Finds the target in the next frame. The frame is analyzed by the
+ * ObjectDetector if it is time for a full detection or the target is not being
+ * tracked. Otherwise the points of the last frame are followed into this one.
+ * If that fails, the frame is analyzed by the ObjectDetector as well.
+ *
+ * @param  frame         the next frame from the camera.
+ * @param  searchRegion  the part of the frame a full detection searches, an empty Rect means the whole frame.
+ * @param  expectedShift how far the image is expected to have moved since the last frame.
+ * @return               the ObjectBox of the target.
+ */
+ObjectBox * TargetTracker::processFrame(cv::Mat frame, cv::Rect searchRegion, cv::Point2f expectedShift)
+{
+    cv::cvtColor(frame, currentFrame, CV_BGR2GRAY);
+
+    ObjectBox * objectBox = NULL;
+
+    if (tracking && framesSinceDetection < detectionInterval) {
+        objectBox = track(expectedShift);
+    }
+    if (objectBox == NULL) {
+        objectBox = detect(frame, searchRegion);
+    }
+
+    cv::swap(previousFrame, currentFrame);
+    return objectBox;
+}
+
+/**
+ * Forgets the tracked points, so the next frame is analyzed by the
+ * ObjectDetector. This is necessary if the camera moved in an unknown way.
+ */
+void TargetTracker::reset()
+{
+    tracking             = false;
+    framesSinceDetection = 0;
+    detectedPointCount   = 0;
+    detectedConfidence   = 0;
+}
+
+/**
+ * Returns whether the ObjectBox of the last frame was tracked or detected.
+ *
+ * @return true if it was tracked
+ */
+bool TargetTracker::lastFrameWasTracked()
+{
+    return tracked;
+}
+
+// MARK: PRIVATE
+
+/**
+ * Analyzes the frame with the ObjectDetector. If the target was found, its
+ * inlier points are tracked from now on.
+ *
+ * @param  frame        the frame to analyze.
+ * @param  searchRegion the part of the frame to search.
+ * @return              the detected ObjectBox.
+ */
+ObjectBox * TargetTracker::detect(cv::Mat frame, cv::Rect searchRegion)
+{
+    ObjectBox * objectBox = objectDetector->processFrameUsingSURFandFLANN(frame, searchRegion);
+
+    objectDetector->getInlierPoints(targetPoints, scenePoints);
+
+    tracked              = false;
+    tracking             = objectBox->objectDetected() && scenePoints.size() >= TRACKER_MIN_POINTS;
+    framesSinceDetection = 0;
+    detectedPointCount   = scenePoints.size();
+    detectedConfidence   = objectBox->getConfidence();
+
+    return objectBox;
+}
+
+/**
+ * Follows the points of the last frame into the current one and fits the
+ * homography to the points that were found again. Points that are lost or do
+ * not fit the homography are not tracked any further.
+ *
+ * @param  expectedShift how far the points are expected to have moved, used as the first guess.
+ * @return               the tracked ObjectBox or NULL if the track was lost.
+ */
+ObjectBox * TargetTracker::track(cv::Point2f expectedShift)
+{
+    nextPoints = std::vector<cv::Point2f>{};
+    for (int i = 0; i < scenePoints.size(); i++) nextPoints.push_back(scenePoints[i] + expectedShift);
+
+    cv::calcOpticalFlowPyrLK(previousFrame, currentFrame, scenePoints, nextPoints, status, errors,
+                             cv::Size(21, 21), 3, cv::TermCriteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, 30, 0.01),
+                             cv::OPTFLOW_USE_INITIAL_FLOW);
+
+    std::vector<cv::Point2f> foundTargetPoints, foundScenePoints;
+
+    for (int i = 0; i < status.size(); i++) {
+        if (status[i]) {
+            foundTargetPoints.push_back(targetPoints[i]);
+            foundScenePoints.push_back(nextPoints[i]);
+        }
+    }
+
+    if (foundScenePoints.size() < TRACKER_MIN_POINTS) return NULL;
+
+    H = cv::findHomography(foundTargetPoints, foundScenePoints, CV_RANSAC, 3, inlierMask);
+    if (H.empty()) return NULL;
+
+    targetPoints = std::vector<cv::Point2f>{};
+    scenePoints  = std::vector<cv::Point2f>{};
+
+    for (int i = 0; i < inlierMask.size(); i++) {
+        if (inlierMask[i]) {
+            targetPoints.push_back(foundTargetPoints[i]);
+            scenePoints.push_back(foundScenePoints[i]);
+        }
+    }
+
+    float trackedShare = (float) scenePoints.size() / detectedPointCount;
+    if (scenePoints.size() < TRACKER_MIN_POINTS || trackedShare < TRACKER_MIN_CONFIDENCE) return NULL;
+
+    ObjectBox * objectBox = new ObjectBox(targetCornersInFrame(H), detectedConfidence * trackedShare);
+
+    // A tracked box that does not look like the target means the track drifted off.
+    if (!objectBox->objectDetected()) {
+        delete objectBox;
+        return NULL;
+    }
+
+    tracked = true;
+    framesSinceDetection++;
+    return objectBox;
+}
+
+/**
+ * Maps the corners of the target image into the frame.
+ *
+ * @param  homography maps points of the target image into the frame.
+ * @return            the corners a, b, c and d in the frame.
+ */
+std::array<cv::Point2f, 4> TargetTracker::targetCornersInFrame(const cv::Mat & homography)
+{
+    const cv::Mat & targetImage = targetModel->getTargetImage();
+
+    std::vector<cv::Point2f> targetCorners(4), sceneCorners(4);
+    targetCorners[0] = cv::Point2f(               0,                0);
+    targetCorners[1] = cv::Point2f(targetImage.cols,                0);
+    targetCorners[2] = cv::Point2f(targetImage.cols, targetImage.rows);
+    targetCorners[3] = cv::Point2f(               0, targetImage.rows);
+
+    cv::perspectiveTransform(targetCorners, sceneCorners, homography);
+
+    return {sceneCorners[0], sceneCorners[1], sceneCorners[2], sceneCorners[3]};
+}
@@ -0,0 +1,70 @@
+/*! \class TargetTracker TargetTracker.hpp "TargetTracker.hpp"
+**
+** The TargetTracker combines the full detection of the ObjectDetector with
+** optical flow tracking. Only every detectionInterval-th frame is analyzed by
+** the ObjectDetector. The points that were matched consistently with the
+** homography of that detection are then followed from frame to frame with
+** pyramidal Lucas-Kanade optical flow, and the homography is fitted again to
+** the tracked points. This is a lot cheaper than a full detection, so the
+** position of the target can be updated at the frame rate of the camera.
+**
+** The ObjectBoxes of tracked frames carry a confidence: the confidence of the
+** detection, scaled by the share of the detected points that are still
+** tracked and consistent with the homography. If that share drops too low, or
+** too few points are left, the track is lost and the frame is analyzed by the
+** ObjectDetector again.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef TARGETTRACKER_HPP
+#define TARGETTRACKER_HPP
+
+#include <array>
+#include <vector>
+#include "opencv2/core/core.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+#include "opencv2/video/tracking.hpp"
+#include "opencv2/calib3d/calib3d.hpp"
+
+#include "ObjectDetector.hpp"
+#include "TargetModel.hpp"
+#include "Logger.hpp"
+
+/** Minimum number of tracked points to fit a homography to. */
+#define TRACKER_MIN_POINTS 8
+/** Below this share of the detected points the track is considered lost. */
+#define TRACKER_MIN_CONFIDENCE 0.3
+
+class ObjectBox;
+
+class TargetTracker {
+
+public:
+
+    TargetTracker(TargetModel * targetModel, ObjectDetector * objectDetector, int detectionInterval);
+    ObjectBox * processFrame(cv::Mat frame, cv::Rect searchRegion = cv::Rect(), cv::Point2f expectedShift = cv::Point2f(0, 0));
+    void        reset();
+    bool        lastFrameWasTracked();
+
+private:
+
+    TargetModel *    targetModel;
+    ObjectDetector * objectDetector;
+    int              detectionInterval;
+    int              framesSinceDetection;
+    bool             tracking, tracked;
+    int              detectedPointCount;
+    float            detectedConfidence;
+
+    cv::Mat                  previousFrame, currentFrame, H;
+    std::vector<cv::Point2f> targetPoints, scenePoints, nextPoints;
+    std::vector<uchar>       status, inlierMask;
+    std::vector<float>       errors;
+
+    ObjectBox * detect(cv::Mat frame, cv::Rect searchRegion);
+    ObjectBox * track(cv::Point2f expectedShift);
+    std::array<cv::Point2f, 4> targetCornersInFrame(const cv::Mat & homography);
+};
+
+#endif //TARGETTRACKER_HPP
@@ -20,6 +20,7 @@ VehicleController::VehicleController()
     leftSlope      = properties->getFloatPropertyWithName("vehicle_turn_left_slope");
     rightIntersect = properties->getFloatPropertyWithName("vehicle_turn_right_intersect");
     rightSlope     = properties->getFloatPropertyWithName("vehicle_turn_right_slope");
+    motion         = VehicleMotion{false, true, 0, 0};
 
     init();
 }
@@ -63,6 +64,46 @@ void VehicleController::init()
     sleep(2);
 }
 
+/**
+ * This function receives a command and sends it to the Arduino. The vehicle
+ * keeps moving until the stop command is sent, so it is not known how far the
+ * camera image moves.
+ *
+ * @param: the command the Arduino is supposed to exectue
+ */
+void VehicleController::executeCommand(VehicleController::vehicleCommand command)
+{
+    sendCommand(command);
+
+    std::lock_guard<std::mutex> lock(motionMutex);
+    if (command != vehicleCommand::stop) motion.shiftKnown = false;
+}
+
+/**
+* This method executes a vehicle command for a specified time before it sends
+* the stop command to the vehicle. The horizontal shift of the camera image
+* that a turn causes is added to the expected pixel shift, the time driven
+* forward (positive) or backward (negative) is added up as well.
+*
+* @param command: command that to be executeCommand
+* @param time: the time that the command should be executed for in milliseconds
+*/
+void VehicleController::executeCommand(vehicleCommand command, int time)
+{
+    sendCommand(command);
+    usleep(std::abs(time) * 1000);
+    sendCommand(vehicleCommand::stop);
+
+    std::lock_guard<std::mutex> lock(motionMutex);
+    motion.moved = true;
+
+    // turning left moves the target to the right in the image and vice versa.
+    if      (command == vehicleCommand::left)  motion.pixelShift += pixelsForTurn(command, std::abs(time));
+    else if (command == vehicleCommand::right) motion.pixelShift -= pixelsForTurn(command, std::abs(time));
+    else if (command == vehicleCommand::forward)  motion.driveTime += std::abs(time);
+    else if (command == vehicleCommand::backward) motion.driveTime -= std::abs(time);
+}
+
 /**
  * This function receives a command and writes the corresponding
  * character to the Arduino's serial port so that the arduino can
@@ -70,10 +111,15 @@ void VehicleController::init()
  *
  * @param: the command the Arduino is supposed to exectue
  */
-void VehicleController::executeCommand(VehicleController::vehicleCommand command)
+void VehicleController::sendCommand(VehicleController::vehicleCommand command)
 {
     const char * tempCommand = "";
 
+    if (command != vehicleCommand::stop) {
+        std::lock_guard<std::mutex> lock(motionMutex);
+        motion.moved = true;
+    }
+
     switch (command) {
         case forward : tempCommand = "f"; break;
         case backward: tempCommand = "b"; break;
@@ -87,20 +133,6 @@ void VehicleController::executeCommand(VehicleController::vehicleCommand command
     // printf("VehicleController: %zi bytes write : %s\n", n, tempCommand);
 }
 
-/**
-* This method executes a vehicle command for a specified time before it sends
-* the stop command to the vehicle.
-*
-* @param command: command that to be executeCommand
-* @param time: the time that the command should be executed for in milliseconds
-*/
-void VehicleController::executeCommand(vehicleCommand command, int time)
-{
-    executeCommand(command);
-    usleep(std::abs(time) * 1000);
-    executeCommand(vehicleCommand::stop);
-}
-
 /**
  * This function executes a turn command (either left or right vehicleCommand)
  * for a specified number of pixels. It therefore translates the number of pixels
@@ -127,6 +159,24 @@ void VehicleController::executeTurnPixelCommand(enum vehicleCommand turnCommand,
     }
 }
 
+// MARK: Expected motion
+
+/**
+ * Returns how the vehicle moved since the last call and starts counting
+ * again. Both happen at once, so a command that is executed meanwhile on
+ * another thread is not lost.
+ *
+ * @return the motion since the last call.
+ */
+VehicleMotion VehicleController::takeMotion()
+{
+    std::lock_guard<std::mutex> lock(motionMutex);
+
+    VehicleMotion result = motion;
+    motion               = VehicleMotion{false, true, 0, 0};
+    return result;
+}
+
 /**
  * This function closes the connection to the Arduino.
  */
@@ -135,3 +185,20 @@ void VehicleController::closeArduino()
     close(fd);
     printf("VehicleController: Arduino released!");
 }
+
+// MARK: PRIVATE
+
+/**
+ * Translates the duration of a turn back into the number of pixels the camera
+ * image moves. It is the inverse of the linear function that is used by
+ * executeTurnPixelCommand().
+ *
+ * @param  turnCommand either left or right.
+ * @param  time        the duration of the turn in milliseconds.
+ * @return             the number of pixels.
+ */
+int VehicleController::pixelsForTurn(enum vehicleCommand turnCommand, int time)
+{
+    float pixel = turnCommand == vehicleCommand::left ? (time - leftIntersect) / leftSlope : (time - rightIntersect) / rightSlope;
+    return std::max(0, (int) pixel);
+}
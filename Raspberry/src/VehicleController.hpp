@@ -3,6 +3,12 @@
 ** The VehicleController class opens up a serial port Connection to the
 ** Arduino and provides functions to execute different commands on the
 ** Arduino and to close the connection to the Arduino.
+** It also keeps track of how far the camera image is expected to have moved
+** because of the commands, so the VideoProcessor knows where to look for the
+** target in the next frame, and how long it drove forward or backward.
+** The commands can come from another thread than the one that takes the
+** motion (e.g. the SDL window in manual mode), so the motion is guarded by a
+** mutex and taken as a whole.
 **
 ** @author Daniel Palenicek
 ** @version 1.0 / 24.08.2016
@@ -20,10 +26,23 @@
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
+#include <algorithm>
+#include <mutex>
 
 #include "Properties.hpp"
 #include "Logger.hpp"
 
+/**
+ * How the vehicle moved since the motion was taken the last time.
+ */
+struct VehicleMotion
+{
+    bool moved;      // any command other than stop was executed.
+    bool shiftKnown; // false if the vehicle moved without a time limit.
+    int  pixelShift; // how many pixels the image is expected to have moved to the right.
+    int  driveTime;  // milliseconds driven forward (negative: backward).
+};
+
 class VehicleController {
 
 public:
@@ -42,14 +61,21 @@ public:
     void executeTurnPixelCommand(enum vehicleCommand turnCommand, int pixel);
     void closeArduino();
 
+    // MARK: Expected motion
+    VehicleMotion takeMotion();
+
 private:
 
     int          fd = -1;
     const char * port; // The port's identifier that the Arduino is connected to.
     float leftIntersect, leftSlope;
     float rightIntersect, rightSlope;
+    VehicleMotion motion;
+    std::mutex    motionMutex;
 
     void init();
+    void sendCommand(enum vehicleCommand command);
+    int  pixelsForTurn(enum vehicleCommand turnCommand, int time);
 };
 
 #endif //VEHICLECONTROLLER_HPP
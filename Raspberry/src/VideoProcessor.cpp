@@ -6,14 +6,27 @@
 */
 
 #include "VideoProcessor.hpp"
+#include "VehicleController.hpp"
+#include "LauncherController.hpp"
+#include "Dashboard.hpp"
+#include "CameraFrameSource.hpp"
+#include "RecordingFrameSource.hpp"
+#include "ReplayFrameSource.hpp"
 
 std::string vehicleTurnPath;
 
 /**
  * The video processor constructor sets up all the necessary properties to use
  * the class. It also
+ *
+ * @param relativePosition  receives the ObjectBoxes of the analyzed frames.
+ * @param vehicleController tells how far the image moved since the last frame,
+ *                          can be NULL if the vehicle is not used.
+ * @param launcherController tells whether the launcher moved since the last
+ *                          frame, can be NULL if the launcher is not used.
+ * @param headless          if set, no window is opened and nothing is drawn.
  */
-VideoProcessor::VideoProcessor(RelativePosition * relativePosition)
+VideoProcessor::VideoProcessor(RelativePosition * relativePosition, VehicleController * vehicleController, LauncherController * launcherController, bool headless)
 {
     Logger::debug("VideoProcessor Constructor");
     frameNumber = 0;
@@ -28,24 +41,118 @@ VideoProcessor::VideoProcessor(RelativePosition * relativePosition)
     maxBufferSize           = properties->getNumberPropertyWithName("max_buffer_size");
     threasholdMultiplicator = properties->getNumberPropertyWithName("threashold_multiplicator");
     frameDebuggingOutput    = properties->getNumberPropertyWithName("frame_debugging_output");
+    captureThread           = properties->getNumberPropertyWithName("vp_capture_thread") == 1;
+    pipelined               = properties->getNumberPropertyWithName("vp_pipeline") == 1;
+    pipelineQueueSize       = properties->getNumberPropertyWithName("vp_pipeline_queue_size");
+    detectionWorkers        = properties->getNumberPropertyWithName("vp_detection_workers");
+    tracking                = properties->getNumberPropertyWithName("vp_tracking") == 1;
+    trackingMargin          = properties->getFloatPropertyWithName("vp_tracking_margin");
+    trackerInterval         = properties->getNumberPropertyWithName("vp_tracker_interval");
+    renderThread            = properties->getNumberPropertyWithName("vp_render_thread") == 1;
+    ObjectBox::setMinConfidence(properties->getFloatPropertyWithName("vp_min_sample_confidence"));
+    this->vehicleController = vehicleController;
+    this->launcherController = launcherController;
+    expectedShift           = 0;
+    expectedShiftKnown      = true;
+    this->headless          = headless;
+
+    FeatureSettings featureSettings = featureSettingsFromProperties();
+
+    DetectorSettings detectorSettings;
+    detectorSettings.matcherType          = TargetMatcher::matcherTypeWithName(properties->getStringPropertyWithName("vp_matcher"));
+    detectorSettings.ratio                = properties->getFloatPropertyWithName("vp_ratio_test");
+    detectorSettings.keypointTarget       = properties->getNumberPropertyWithName("vp_keypoint_target");
+    detectorSettings.maxKeypoints         = properties->getNumberPropertyWithName("vp_max_keypoints");
+    detectorSettings.minHessian           = properties->getFloatPropertyWithName("vp_min_adaptive_Hessian");
+    detectorSettings.maxHessian           = properties->getFloatPropertyWithName("vp_max_adaptive_Hessian");
+    detectorSettings.frameDebuggingOutput = frameDebuggingOutput == 1;
+    detectorSettings.guidedMatching       = properties->getNumberPropertyWithName("vp_guided_matching") == 1;
+    detectorSettings.guidedRadius         = properties->getFloatPropertyWithName("vp_guided_radius");
+    detectorSettings.guidedMinMatches     = properties->getNumberPropertyWithName("vp_guided_min_matches");
+    detectorSettings.homographyModel      = HomographyEstimator::modelTypeWithName(properties->getStringPropertyWithName("vp_homography_model"));
+
+    std::string targetCachePath   = properties->getStringPropertyWithName("vp_target_cache_path");
+    std::string targetLibraryList = properties->getStringPropertyWithName("vp_target_library");
+    std::string vocabularyPath    = properties->getStringPropertyWithName("vp_target_vocabulary");
+
+    sceneCache     = properties->getNumberPropertyWithName("vp_scene_cache") == 1 ? new SceneCache() : NULL;
+    targetModel    = new TargetModel(targetImagePath, targetCachePath, featureSettings);
+    objectDetector = new ObjectDetector(targetModel, detectorSettings, sceneCache);
+    workerPool     = NULL;
+    targetTracker  = NULL;
+    targetLibrary       = NULL;
+    multiTargetDetector = NULL;
+    vocabulary          = NULL;
+
+    if (vocabularyPath != "none") {
+        vocabulary          = new VocabularyTree(vocabularyPath, featureSettings);
+        targetLibrary       = new TargetLibrary(vocabulary->getTargetPaths(), targetCachePath, featureSettings);
+        multiTargetDetector = new MultiTargetDetector(targetLibrary, detectorSettings, vocabulary,
+                                                      properties->getNumberPropertyWithName("vp_vocabulary_candidates"));
+    } else if (targetLibraryList != "none") {
+        targetLibrary       = new TargetLibrary(TargetLibrary::splitPaths(targetLibraryList), targetCachePath, featureSettings);
+        multiTargetDetector = new MultiTargetDetector(targetLibrary, detectorSettings);
+    } else if (trackerInterval > 0) {
+        targetTracker = new TargetTracker(targetModel, objectDetector, trackerInterval);
+
+        // The tracker takes a single frame per call, the sampling options have nothing to do.
+        if (pipelined || detectionWorkers > 0 || properties->getNumberPropertyWithName("vp_sequential_sampling") == 1) {
+            printf("Warning: vp_tracker_interval is on, vp_pipeline, vp_detection_workers and vp_sequential_sampling are not used\n");
+        }
+    } else if (detectionWorkers > 0) {
+        workerPool = new DetectionWorkerPool(targetModel, detectorSettings, detectionWorkers, sceneCache);
+    }
 
-
-    targetImage = cv::imread(targetImagePath, CV_LOAD_IMAGE_GRAYSCALE);
-    //cv::Mat sceneFrame = cv::imread(testScenceImagePath, CV_LOAD_IMAGE_GRAYSCALE);;
+    // Set up the target right away so the first frame does not have to wait for it.
+    // If this fails the ObjectDetectors try again and report the error per frame.
+    try {
+        if      (vocabulary    != NULL) printf("VocabularyTree: %d targets, %d words\n", vocabulary->targetCount(), vocabulary->wordCount());
+        else if (targetLibrary != NULL) targetLibrary->setUp();
+        else                            targetModel->setUpSURFandFLANN();
+    }
+    catch (Exception &e) {
+        std::cout << "Exception setting up target.\n" << e.what() << std::endl;
+    }
 
     windowName     = properties->getStringPropertyWithName("webcam_window_name");
     webcamIdentifier= properties->getNumberPropertyWithName("webcam_device_name");
     this->relativePosition = relativePosition;
 
-    cap = new cv::VideoCapture(webcamIdentifier);
-    if(!cap->isOpened()) {
-        throw DeviceNotFoundException("Webcam", std::to_string(webcamIdentifier));
+    std::string recordingPath = properties->getStringPropertyWithName("vp_recording_path");
+
+    switch (FrameSource::sourceTypeWithName(properties->getStringPropertyWithName("vp_frame_source"))) {
+        case FrameSource::sourceType::camera:
+            cap = new CameraFrameSource(webcamIdentifier);
+            break;
+        case FrameSource::sourceType::record:
+            cap = new RecordingFrameSource(new CameraFrameSource(webcamIdentifier), recordingPath,
+                                           properties->getStringPropertyWithName("vp_recording_format"),
+                                           properties->getNumberPropertyWithName("vp_recording_quality"));
+            break;
+        case FrameSource::sourceType::replay: {
+            bool replayRealTime = properties->getNumberPropertyWithName("vp_replay_real_time") == 1;
+            cap = new ReplayFrameSource(recordingPath, replayRealTime);
+            // The capture thread would drop frames that are replayed faster than they are analyzed.
+            if (!replayRealTime) captureThread = false;
+            break;
+        }
+    }
+
+    frameGrabber = NULL;
+    frameNotCapturedBefore = std::chrono::steady_clock::now();
+    qualityGate  = new FrameQualityGate();
+
+    if (captureThread) {
+        frameGrabber = new FrameGrabber(cap);
+        frameGrabber->start();
     }
 
     //time(&timeLastFrameCaptured); // TODO: this can probably go.
     //*cap >> frame;
     getNextFrameFromCamera();
-    cv::namedWindow(windowName, 1);
+
+    dashboard = NULL;
+    if (!headless) dashboard = new Dashboard(windowName, renderThread);
 }
 
 /**
@@ -60,8 +167,9 @@ int VideoProcessor::startCapturing(void)
         //usleep(2000000);
         //showNextFrame();
         processNextFrame();
+        if (dashboard == NULL) continue;
         //if (cv::waitKey(10) == 27) capturing = false;
-        switch (cv::waitKey(10)) {
+        switch (dashboard->takeKey()) {
             case 27 : capturing = false; break;
             //case
         }
@@ -76,29 +184,286 @@ void VideoProcessor::showNextFrame(void)
 {
     getNextFrameFromCamera();
 
-    cv::line(frame, cv::Point2f(WEBCAM_WIDTH/2,0), cv::Point2f(WEBCAM_WIDTH/2,WEBCAM_HEIGHT), cv::Scalar(0, 255, 0), 2 );
+    if (dashboard == NULL) return;
 
-    cv::imshow(windowName, frame);
-    cv::waitKey(10);
+    DashboardSnapshot snapshot;
+    snapshot.frame      = frame.clone();
+    snapshot.centerLine = true;
+    dashboard->show(snapshot);
 }
 
 /**
  * This function generates the next relative position object by processing frames as many frames as samples are needed. It then presents the frame.
+ * If the camera did not move, the samples of earlier calls are still valid and
+ * may already be enough, so no new frame has to be captured.
  *
  * @method VideoProcessor::processNextFrame
  */
 void VideoProcessor::processNextFrame()
 {
-    for (int i = 0; i<sampleSize; i++) {
-        relativePosition->addSampleBox(processFrameUsingSURFandFLANN(getNextFrameFromCamera()));
+    takeMotion();
+
+    if (targetTracker != NULL && !expectedShiftKnown) targetTracker->reset();
+
+    // The other targets could be anywhere, so with several targets the whole frame is searched.
+    searchRegion = multiTargetDetector == NULL ? trackingRegion() : cv::Rect();
+    collectSamples();
+
+    // The target was not where it was expected, so search the whole frame.
+    if (searchRegion.area() > 0 && !relativePosition->objectDetected()) {
+        if (frameDebuggingOutput == 1) printf("Target lost in search region, searching the whole frame\n");
+
+        relativePosition->clearSampleBoxes();
+        searchRegion = cv::Rect();
+        collectSamples();
+    }
+
+    if (dashboard != NULL) {
+        DashboardSnapshot snapshot;
+        snapshot.frame        = frame.clone();
+        snapshot.sampleBoxes  = relativePosition->getSampleBoxes();
+        snapshot.hasObjectBox = relativePosition->getObjectBox() != NULL;
+        snapshot.searchRegion = searchRegion;
+        if (snapshot.hasObjectBox) snapshot.objectBox = *relativePosition->getObjectBox();
+        for (int t = 0; t < relativePosition->getTargetCount(); t++) {
+            if (relativePosition->getTargetObjectBox(t) != NULL) snapshot.targetBoxes.push_back(*relativePosition->getTargetObjectBox(t));
+        }
+        dashboard->show(snapshot);
+    }
+
+    expectedShift      = 0;
+    expectedShiftKnown = true;
+}
+
+/**
+ * Lets the RelativePosition predict the target after the vehicle moved instead
+ * of analyzing new frames. The camera does not have to settle for that.
+ * The next call of processNextFrame() still knows about the motion.
+ *
+ * @return whether the prediction was certain enough to be used.
+ */
+bool VideoProcessor::predictNextFrame()
+{
+    takeMotion();
+    return relativePosition->usePrediction();
+}
+
+/**
+ * Analyzes as many frames as samples are needed, hands the resulting
+ * ObjectBoxes to the RelativePosition and lets it fuse them into the new
+ * ObjectBox. Only the searchRegion of the frames is searched for the target.
+ * The RelativePosition decides how many samples are needed, at most
+ * sampleSize.
+ * With the tracker a single frame is enough, because it is either a full
+ * detection or tracked from the frames before.
+ * With several targets every frame yields a sample of each target.
+ */
+void VideoProcessor::collectSamples()
+{
+    if (multiTargetDetector != NULL) {
+        while (relativePosition->samplesNeeded(sampleSize) > 0) {
+            relativePosition->addTargetSampleBoxes(multiTargetDetector->processFrame(getNextFrameFromCamera()));
+        }
+    } else if (targetTracker != NULL) {
+        // The tracker already combines the frames, its last box is the only sample.
+        relativePosition->clearSampleBoxes();
+        relativePosition->addSampleBox(targetTracker->processFrame(getNextFrameFromCamera(), searchRegion, cv::Point2f(expectedShift, 0)));
+        expectedShift = 0;
+    } else if (pipelined) {
+        // the pipeline fuses the samples itself while its stages shut down.
+        processSamplesPipelined();
+        return;
+    } else if (workerPool != NULL) {
+        // the frames are analyzed by the workers while the next one is captured.
+        // Only as many frames are in flight as could still change the decision.
+        std::deque< std::future<ObjectBox *> > samples;
+        int needed;
+        while ((needed = relativePosition->samplesNeeded(sampleSize)) > 0) {
+            while (samples.size() < needed) {
+                samples.push_back(workerPool->submit(getNextFrameFromCamera().clone(), searchRegion));
+            }
+            relativePosition->addSampleBox(samples.front().get());
+            samples.pop_front();
+        }
+        // Samples that are not needed anymore still have to finish.
+        while (!samples.empty()) {
+            delete samples.front().get();
+            samples.pop_front();
+        }
+    } else {
+        while (relativePosition->samplesNeeded(sampleSize) > 0) {
+            relativePosition->addSampleBox(processFrameUsingSURFandFLANN(getNextFrameFromCamera()));
+        }
     }
 
     relativePosition->processSampleBoxes();
-    relativePosition->drawKeyPointsOntoCVMat(frame, cv::Point2f(0, 0));
-    //relativePosition->drawKeyPointsOntoCVMat(dashboardFrame, cv::Point2f( targetImage.cols, 0));
+}
+
+/**
+ * Asks the VehicleController how the vehicle moved since this was last called.
+ * Without a VehicleController it is assumed that the vehicle moved, but not
+ * sideways. The LauncherController only tells whether the launcher moved, so
+ * the shift is not known then.
+ * The shift is added up until the next frame was processed. The samples, the
+ * SceneCache and the guidance of the ObjectDetectors are dropped and the
+ * RelativePosition is told about the motion right away.
+ */
+void VideoProcessor::takeMotion()
+{
+    VehicleMotion motion        = VehicleMotion{true, true, 0, 0};
+    bool          launcherMoved = launcherController != NULL && launcherController->movedSinceLastCheck();
+
+    if (vehicleController != NULL) motion = vehicleController->takeMotion();
+    if (!motion.moved && !launcherMoved) return;
+
+    bool shiftKnown     = motion.shiftKnown && !launcherMoved;
+    expectedShift      += motion.pixelShift;
+    expectedShiftKnown  = expectedShiftKnown && shiftKnown;
+
+    // Only frames that were captured after the camera settled are useful, and
+    // the samples of earlier frames do not show the current scene anymore.
+    frameNotCapturedBefore = std::chrono::steady_clock::now();
+    qualityGate->motionCommanded();
+    if (sceneCache != NULL) sceneCache->invalidate();
+    objectDetector->invalidateGuidance();
+    if (workerPool != NULL) workerPool->invalidateGuidance();
+    relativePosition->clearSampleBoxes();
+    relativePosition->applyCameraMotion(motion.pixelShift, motion.driveTime, shiftKnown);
+}
+
+/**
+ * Calculates the part of the frame the target is expected to be in. It is the
+ * bounding box of the last ObjectBox, moved by the pixels the vehicle turned
+ * since then and grown by the tracking margin on every side. The region covers
+ * the old and the moved position, because the turn is only an estimate.
+ * If the target was not detected last time, tracking is disabled, or the
+ * vehicle moved for an unknown time, the whole frame has to be searched.
+ *
+ * @return the search region, an empty Rect means the whole frame.
+ */
+cv::Rect VideoProcessor::trackingRegion()
+{
+    ObjectBox * lastObjectBox = relativePosition->getObjectBox();
+
+    if (!tracking || !expectedShiftKnown || lastObjectBox == NULL || !lastObjectBox->objectDetected()) return cv::Rect();
+
+    std::array<cv::Point2f, 4> corners = lastObjectBox->getObjectCornerPoints();
+    cv::Rect box    = cv::boundingRect(std::vector<cv::Point2f>(corners.begin(), corners.end()));
+    cv::Rect region = box | (box + cv::Point(expectedShift, 0));
+
+    int marginX = box.width  * trackingMargin;
+    int marginY = box.height * trackingMargin;
 
-    cv::imshow(windowName, frame);
-    cv::waitKey(10);
+    region  = cv::Rect(region.x - marginX, region.y - marginY, region.width + 2 * marginX, region.height + 2 * marginY);
+    region &= cv::Rect(0, 0, WEBCAM_WIDTH, WEBCAM_HEIGHT);
+
+    if (region.width < TRACKING_MIN_REGION_SIZE || region.height < TRACKING_MIN_REGION_SIZE) return cv::Rect();
+
+    return region;
+}
+
+/**
+ * This function does the same as the sample loop in collectSamples() but runs
+ * capturing, detection and fusion as three stages that are connected through
+ * bounded queues. While frame N is analyzed, frame N+1 is already captured and
+ * the sample boxes are handed to the RelativePosition as soon as they are
+ * ready, which decides after every sample whether more are needed.
+ * If there is a worker pool the detection stage only hands the frames to the
+ * workers, so several frames are analyzed at once.
+ * The capture stage clones the frames because the camera reuses its buffer.
+ * Once the RelativePosition needs no more samples the queues are closed, which
+ * stops the other stages. The samples are fused while the stages finish the
+ * frames they are still working on.
+ * The camera state (frame, frameNumber and the FrameQualityGate) belongs to
+ * the capture stage until it is joined, the calling thread does not touch it
+ * while the pipeline runs.
+ * Exceptions that occur in one of the stages are rethrown on the calling
+ * thread once all stages finished.
+ *
+ * @method VideoProcessor::processSamplesPipelined
+ */
+void VideoProcessor::processSamplesPipelined()
+{
+    int detectionQueueSize = std::max(pipelineQueueSize, detectionWorkers);
+
+    BoundedQueue<cv::Mat>                  frameQueue(pipelineQueueSize);
+    BoundedQueue<std::future<ObjectBox *>> boxQueue(detectionQueueSize);
+    std::exception_ptr captureError, detectionError, fusionError;
+
+    std::thread captureStage([&] {
+        try {
+            for (int i = 0; i < sampleSize; i++) {
+                if (!frameQueue.push(getNextFrameFromCamera().clone())) break;
+            }
+        }
+        catch (...) {
+            captureError = std::current_exception();
+        }
+        frameQueue.close();
+    });
+
+    std::thread detectionStage([&] {
+        try {
+            cv::Mat sample;
+            while (frameQueue.pop(sample)) {
+                if (!boxQueue.push(detectSample(sample))) break;
+            }
+        }
+        catch (...) {
+            detectionError = std::current_exception();
+            frameQueue.close();
+        }
+        boxQueue.close();
+    });
+
+    // fusion stage
+    try {
+        std::future<ObjectBox *> sampleBox;
+        while (relativePosition->samplesNeeded(sampleSize) > 0 && boxQueue.pop(sampleBox)) {
+            relativePosition->addSampleBox(sampleBox.get());
+        }
+        // The decision was made early, so stop capturing and analyzing.
+        frameQueue.close();
+        boxQueue.close();
+        relativePosition->processSampleBoxes();
+    }
+    catch (...) {
+        fusionError = std::current_exception();
+        frameQueue.close();
+        boxQueue.close();
+    }
+
+    captureStage.join();
+    detectionStage.join();
+
+    // Samples that were analyzed after the decision are not needed anymore.
+    std::future<ObjectBox *> unusedBox;
+    while (boxQueue.pop(unusedBox)) {
+        try { delete unusedBox.get(); } catch (...) {}
+    }
+
+    if (captureError)   std::rethrow_exception(captureError);
+    if (detectionError) std::rethrow_exception(detectionError);
+    if (fusionError)    std::rethrow_exception(fusionError);
+}
+
+/**
+ * Starts the analysis of a sample frame. With a worker pool the frame is
+ * analyzed by the next free worker, otherwise it is analyzed right away on the
+ * calling thread.
+ *
+ * @param  sampleFrame the frame to analyze.
+ * @return             a future that holds the resulting ObjectBox.
+ */
+std::future<ObjectBox *> VideoProcessor::detectSample(cv::Mat sampleFrame)
+{
+    if (workerPool != NULL) {
+        return workerPool->submit(sampleFrame, searchRegion);
+    }
+
+    std::promise<ObjectBox *> result;
+    result.set_value(processFrameUsingSURFandFLANN(sampleFrame));
+    return result.get_future();
 }
 
 /**
@@ -110,15 +475,33 @@ void VideoProcessor::processNextFrame()
  * reading a frame directly from the camera takes significantly longer than reading
  * it from the buffer (the purpose of a buffer) we can throw away all the frames
  * that take less time than the threshold multiplied by a specified factor. If the frame takes long enough to read, we will assume that is read from the camera directly. In order to prevent infinite looping, a maximum buffer size is specified. It is assumed that the buffer is not bigger than said constant. Therefore after maxBufferSize iterations the loop can also be terminated.
+ *
+ * When the capture thread is enabled none of this is necessary. The FrameGrabber
+ * always holds the newest frame, so we simply ask it for the first frame that
+ * was captured after the last one we received (or after the last move).
+ *
+ * After a move, frames are only accepted once the FrameQualityGate considers
+ * them sharp. Without a move there is no delay at all.
  */
 cv::Mat VideoProcessor::getNextFrameFromCamera(void)
 {
-    // The delay is necessary so the camera image is not blury because the roboterState
-    // was not completely standing still yet.
-    usleep(500000);
+    if (captureThread) {
+        // After a move, frames are skipped until one is sharp.
+        do {
+            frame = frameGrabber->getFrameCapturedAfter(frameNotCapturedBefore, &lastFrameCaptureTime);
+            frameNotCapturedBefore = lastFrameCaptureTime;
+        } while (!qualityGate->accept(frame));
+
+        if (frameDebuggingOutput == 1) {
+            printf("Frame No.: %2i -> %ld frames grabbed\n", frameNumber, frameGrabber->getFrameCount());
+        }
+
+        frameNumber++;
+        return frame;
+    }
 
     std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
-    *cap >> frame;
+    cap->read(frame);
     std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
     auto durationThreashold = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
 
@@ -128,10 +511,11 @@ cv::Mat VideoProcessor::getNextFrameFromCamera(void)
 
     int i = 0;
 
-    while (frameSkipping == 1 && i < maxBufferSize) {
+    // Only a camera has a buffer that needs to be skipped.
+    while (frameSkipping == 1 && cap->live() && i < maxBufferSize) {
 
         std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
-        *cap >> frame;
+        cap->read(frame);
         std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
 
@@ -143,108 +527,26 @@ cv::Mat VideoProcessor::getNextFrameFromCamera(void)
         if (duration > threasholdMultiplicator*durationThreashold) break;
     }
 
+    // After a move, frames are read until one is sharp.
+    while (!qualityGate->accept(frame)) {
+        if (!cap->read(frame)) throw DeviceNotFoundException("Webcam stopped delivering frames");
+    }
+
     frameNumber++;
 
     return frame;
 }
 
 /**
- * This method sets up surf and flann properties that only have to be calculated once.
- */
-void VideoProcessor::setUpSURFandFLANN()
-{
-    if( !targetImage.data )  throw FileNotFoundException(targetImagePath);
-    detector = cv::SurfFeatureDetector( minHessian );
-    detector.detect( targetImage, targetKeypoints );
-    extractor.compute( targetImage, targetKeypoints, objectDescriptors );
-    if (objectDescriptors.empty()) std::cout << "object discriptor empty" << std::endl;
-    surfAndFlannSetup = true;
-}
-
-/**
- * This function analyzes a frame using the surf and flann algorithm. It looks for the target, identifies it's corner points and returns an ObjectBox pointer.
+ * This function analyzes a frame on the calling thread. It looks for the target, identifies it's corner points and returns an ObjectBox pointer.
+ * The analysis itself is done by the VideoProcessor's own ObjectDetector.
  *
  * @param currentFrame the frame to be processed
  * @return              The object box pointer
  */
 ObjectBox * VideoProcessor::processFrameUsingSURFandFLANN(cv::Mat currentFrame)
 {
-    try {
-
-        if (!surfAndFlannSetup) {
-            setUpSURFandFLANN();
-        }
-
-        cv::cvtColor(currentFrame, sceneFrame, CV_BGRA2GRAY); // currentFrame;
-
-        if( !sceneFrame.data )   throw FileNotFoundException(" --(!) Error reading frame ");
-
-        // Detect the keypoints using SURF Detector
-        detector.detect( sceneFrame, sceneKeypoints );
-
-        // Calculate descriptors (feature vectors)
-        extractor.compute( sceneFrame, sceneKeypoints, sceneDescriptors );
-
-        if (sceneDescriptors.empty())  std::cout << "sceneVector discriptor empty"  << std::endl;
-
-        matches = std::vector< cv::DMatch >{};
-        matcher.match( objectDescriptors, sceneDescriptors, matches );
-
-        maxDistance = 0;
-        minDistance = 100;
-
-        // Quick calculation of max and min distances between keypoints
-        for( int i = 0; i < objectDescriptors.rows; i++ ) {
-            double distance = matches[i].distance;
-            if( distance < minDistance ) minDistance = distance;
-            if( distance > maxDistance ) maxDistance = distance;
-        }
-
-        goodMatches = std::vector< cv::DMatch >{};
-
-        for( int i = 0; i < objectDescriptors.rows; i++ ) {
-            if( matches[i].distance < 3*minDistance ) {
-                goodMatches.push_back( matches[i]); }
-        }
-
-        cv::drawMatches( targetImage, targetKeypoints, sceneFrame, sceneKeypoints,
-                     goodMatches, dashboardFrame, cv::Scalar::all(-1), cv::Scalar::all(-1),
-                     cv::vector<char>(), cv::DrawMatchesFlags::NOT_DRAW_SINGLE_POINTS );
-
-        // Localize the object
-        targetVector   = std::vector<cv::Point2f>{};
-        sceneVector = std::vector<cv::Point2f>{};
-
-        for( int i = 0; i < goodMatches.size(); i++ )
-        {
-          // Get the keypoints from the good matches
-          targetVector.push_back( targetKeypoints[ goodMatches[i].queryIdx ].pt );
-          sceneVector.push_back( sceneKeypoints[ goodMatches[i].trainIdx ].pt );
-        }
-
-        H = findHomography( targetVector, sceneVector, CV_RANSAC );
-
-        // Get the corners from the image_1 ( the object to be "detected" )
-        std::vector<cv::Point2f> targetCorners(4);
-        targetCorners[0] = cvPoint(                0,                0 );
-        targetCorners[1] = cvPoint( targetImage.cols,                0 );
-        targetCorners[2] = cvPoint( targetImage.cols, targetImage.rows );
-        targetCorners[3] = cvPoint(                0, targetImage.rows );
-        std::vector<cv::Point2f> sceneCorners(4);
-
-        cv::perspectiveTransform( targetCorners, sceneCorners, H);
-
-        // Draw lines between the corners (the mapped object in the sceneVector - image_2 )
-        cornerPoints = {sceneCorners[0], sceneCorners[1], sceneCorners[2],sceneCorners[3]};
-
-        return new ObjectBox(cornerPoints);
-    }
-    catch (Exception &e) {
-        std::cout << "Exception analyizing frame.\n" << e.what() << std::endl;
-    }
-
-    cornerPoints = {cv::Point2f(0,0), cv::Point2f(0,0), cv::Point2f(0,0), cv::Point2f(0,0)};
-    return new ObjectBox(cornerPoints);
+    return objectDetector->processFrameUsingSURFandFLANN(currentFrame, searchRegion);
 }
 
 /**
@@ -257,8 +559,53 @@ int VideoProcessor::getFrameNumber()
     return frameNumber;
 }
 
+/**
+ * Forgets the samples, their history and the SceneCache, so the next
+ * processed frame is detected from scratch. This is for decisions that are
+ * doubted, e.g. a target that is not certain enough to fire at.
+ */
+void VideoProcessor::discardSamples()
+{
+    if (sceneCache != NULL) sceneCache->invalidate();
+    relativePosition->clearSampleBoxes();
+}
+
+/**
+ * Returns the SceneCache, which counts how often the result of an unchanged
+ * scene was reused.
+ *
+ * @return the scene cache, NULL if it is disabled.
+ */
+SceneCache * VideoProcessor::getSceneCache()
+{
+    return sceneCache;
+}
+
+/**
+ * Reads the settings the target and the frames are described with from the
+ * properties file. Everything that describes targets, like the vocabulary
+ * builder, has to use the same settings.
+ *
+ * @return the feature settings
+ */
+FeatureSettings VideoProcessor::featureSettingsFromProperties()
+{
+    Properties * properties = Properties::getInstance();
+
+    FeatureSettings featureSettings;
+    featureSettings.backend               = FeatureSettings::backendTypeWithName(properties->getStringPropertyWithName("vp_feature_backend"));
+    featureSettings.minHessian            = properties->getNumberPropertyWithName("vp_min_Hessian");
+    featureSettings.surfUpright           = properties->getNumberPropertyWithName("vp_surf_upright") == 1;
+    featureSettings.orbFeatures           = properties->getNumberPropertyWithName("vp_orb_features");
+    featureSettings.briskThreshold        = properties->getNumberPropertyWithName("vp_brisk_threshold");
+    featureSettings.fusedDetectAndCompute = properties->getNumberPropertyWithName("vp_fused_detect_compute") == 1;
+    featureSettings.detectionTiles        = properties->getNumberPropertyWithName("vp_detection_tiles");
+    featureSettings.tileOverlap           = properties->getNumberPropertyWithName("vp_detection_tile_overlap");
+    return featureSettings;
+}
+
 /* property that is needed for the mouse callback */
-bool waitingForMouseEvent = true, initialClick = true;
+std::atomic<bool> waitingForMouseEvent(true), initialClick(true);
 
 /**
  * This function is called when a mouse event occourse in the OpenCV window.
@@ -296,7 +643,10 @@ void callback(int event, int x, int y, int flags, void * userdata)
  */
 void VideoProcessor::startTrainingLoop()
 {
-    cv::setMouseCallback(windowName, callback, NULL);
+    // The training needs a click into the window.
+    if (dashboard == NULL) return;
+
+    dashboard->setMouseCallback(callback);
     showNextFrame();
 
     waitForMouseEvent();
@@ -308,6 +658,8 @@ void VideoProcessor::startTrainingLoop()
  */
 void VideoProcessor::waitForMouseEvent()
 {
+    if (dashboard == NULL) return;
+
     while (waitingForMouseEvent) {
         showNextFrame();
         usleep(10000);
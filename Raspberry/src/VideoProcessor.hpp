@@ -3,8 +3,17 @@
 ** This class handles everything that has to do with the launchers camera from
 ** reading the frame from the camera to analyzing the frame and looking for the
 ** target object in the scene.
-** The analysis is done by using SURF and FLANN but can easily be changed by
-** swapping out the the processFrameUsingSURFandFLANN() function.
+** The frames come from a FrameSource, which is either the camera, the camera
+** while its frames are recorded, or a replayed recording.
+** The analysis is done by ObjectDetectors using SURF and FLANN. Each sample
+** frame can either be analyzed on the calling thread or by a pool of workers
+** that analyze several samples at once.
+** With a target library every frame is analyzed by a MultiTargetDetector on
+** the calling thread instead, which looks for all targets at once. A library
+** that is too large to match every frame against is loaded from a
+** VocabularyTree, which shortlists the targets per frame.
+** The frames and the ObjectBoxes are shown by a Dashboard, unless the
+** VideoProcessor runs headless.
 **
 ** @author Daniel Palenicek
 ** @version 0.1 / 29.08.2016
@@ -21,6 +30,11 @@
 #include <time.h>
 #include <chrono>
 #include <string>
+#include <thread>
+#include <exception>
+#include <future>
+#include <deque>
+#include <atomic>
 #include "opencv2/opencv.hpp"
 #include "opencv2/core/core.hpp"
 #include "opencv2/features2d/features2d.hpp"
@@ -33,28 +47,53 @@
 #include "Exceptions.hpp"
 #include "RelativePosition.hpp"
 #include "ObjectBox.hpp"
+#include "FrameSource.hpp"
+#include "FrameGrabber.hpp"
+#include "FrameQualityGate.hpp"
+#include "SceneCache.hpp"
+#include "BoundedQueue.hpp"
+#include "TargetModel.hpp"
+#include "ObjectDetector.hpp"
+#include "DetectionWorkerPool.hpp"
+#include "TargetTracker.hpp"
+#include "TargetLibrary.hpp"
+#include "MultiTargetDetector.hpp"
+#include "VocabularyTree.hpp"
 #include "Logger.hpp"
 
 // webcam specifics
 #define WEBCAM_WIDTH 640
 #define WEBCAM_HEIGHT 480
 #define WEBCAM_DEVNAME 1
+/** Search regions that are smaller than this (in pixels) are not worth tracking. */
+#define TRACKING_MIN_REGION_SIZE 64
 
 class RelativePosition; // Forward Declaration of RelativePosition.
+class ObjectDetector;
+class DetectionWorkerPool;
+class MultiTargetDetector;
+class VehicleController;
+class LauncherController;
+class Dashboard;
 
 class VideoProcessor {
 
 public:
 
-    VideoProcessor(RelativePosition * relativePosition);
+    VideoProcessor(RelativePosition * relativePosition, VehicleController * vehicleController = NULL, LauncherController * launcherController = NULL, bool headless = false);
     int  startCapturing(void);
     int  stopCapturing(void);
     void showNextFrame(void);
     void processNextFrame();
+    bool predictNextFrame();
+    void discardSamples();
     int  getFrameNumber(void);
+    SceneCache * getSceneCache();
     void startTrainingLoop();
     void waitForMouseEvent();
 
+    static FeatureSettings featureSettingsFromProperties();
+
 private:
 
     std::string targetImagePath;
@@ -63,27 +102,57 @@ private:
     //time_t      timeLastFrameCaptured;
     bool    capturing;
     int     webcamIdentifier, minHessian, frameNumber, sampleSize;
-    double  maxDistance, minDistance;
-    cv::Mat frame, targetImage, sceneFrame, dashboardFrame;
-    cv::VideoCapture *  cap;
+    cv::Mat frame;
+    FrameSource *       cap;
     RelativePosition *  relativePosition;
 
     int frameSkipping ,maxBufferSize, threasholdMultiplicator, frameDebuggingOutput;
 
+    // capture thread properties
+    bool           captureThread;
+    FrameGrabber * frameGrabber;
+    FrameGrabber::timePoint frameNotCapturedBefore, lastFrameCaptureTime;
+    FrameQualityGate *      qualityGate;
+
+    // pipeline properties
+    bool pipelined;
+    int  pipelineQueueSize;
+
+    // object detection properties
+    TargetModel *         targetModel;
+    ObjectDetector *      objectDetector;
+    DetectionWorkerPool * workerPool;
+    int                   detectionWorkers;
+    SceneCache *          sceneCache;
+
+    // multi target properties
+    TargetLibrary *       targetLibrary;
+    MultiTargetDetector * multiTargetDetector;
+    VocabularyTree *      vocabulary;
+
+    // tracking properties
+    bool                  tracking;
+    float                 trackingMargin;
+    cv::Rect              searchRegion;
+    VehicleController *   vehicleController;
+    LauncherController *  launcherController;
+    bool                  expectedShiftKnown;
+    int                   expectedShift;
+
+    // optical flow tracking properties
+    TargetTracker *       targetTracker;
+    int                   trackerInterval;
 
-    // SURF and FLANN properties
-    bool surfAndFlannSetup = false;
-    cv::Mat objectDescriptors, sceneDescriptors, H;
-    cv::SurfFeatureDetector     detector;
-    std::vector<cv::KeyPoint>   targetKeypoints, sceneKeypoints;
-    cv::SurfDescriptorExtractor extractor;
-    cv::FlannBasedMatcher       matcher;
-    std::vector<cv::DMatch>     matches, goodMatches;
-    std::vector<cv::Point2f>    targetVector, sceneVector, targetCorners;
-    std::array<cv::Point2f, 4>  cornerPoints;
+    // dashboard properties
+    bool                  headless, renderThread;
+    Dashboard *           dashboard;
 
     cv::Mat     getNextFrameFromCamera(void);
-    void        setUpSURFandFLANN();
+    void        collectSamples();
+    void        processSamplesPipelined();
+    void        takeMotion();
+    cv::Rect    trackingRegion();
+    std::future<ObjectBox *> detectSample(cv::Mat sampleFrame);
     ObjectBox * processFrameUsingSURFandFLANN(cv::Mat currentFrame);
     void        drawFrameNumber(cv::Mat & frame);
 };
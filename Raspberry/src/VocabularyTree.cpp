@@ -0,0 +1,487 @@
+/*
+** @version 0.1 / 17.10.2026
+*/
+
+#include "VocabularyTree.hpp"
+
+/**
+ * Maps a vocabulary file into memory and checks that it was built with the
+ * same feature settings the frames are described with.
+ *
+ * @param path            the vocabulary file that was written by build().
+ * @param featureSettings the settings the frames are described with.
+ */
+VocabularyTree::VocabularyTree(std::string path, FeatureSettings featureSettings)
+{
+    Logger::debug("VocabularyTree Constructor");
+    this->path = path;
+
+    fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor == -1) throw FileNotFoundException(path);
+
+    struct stat fileStatus;
+    fstat(fileDescriptor, &fileStatus);
+    fileSize = fileStatus.st_size;
+
+    if (fileSize < sizeof(VocabularyHeader)) {
+        ::close(fileDescriptor);
+        throw VocabularyException(path, "Not a vocabulary");
+    }
+
+    void * mapping = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+        ::close(fileDescriptor);
+        throw VocabularyException(path, "Can not map vocabulary");
+    }
+    data   = (const uchar *) mapping;
+    header = (const VocabularyHeader *) data;
+
+    try {
+        checkSections();
+        if (header->settingsKey != settingsKey(featureSettings)) {
+            throw VocabularyException(path, "Built with different feature settings");
+        }
+    }
+    catch (...) {
+        munmap(mapping, fileSize);
+        ::close(fileDescriptor);
+        throw;
+    }
+
+    nodes         = (const VocabularyNode *)    (data + header->nodeOffset);
+    centers       = (const float *)             (data + header->centerOffset);
+    weights       = (const float *)             (data + header->weightOffset);
+    postingStarts = (const uint64_t *)          (data + header->postingStartOffset);
+    postings      = (const VocabularyPosting *) (data + header->postingOffset);
+    pathOffsets   = (const uint64_t *)          (data + header->pathOffset);
+}
+
+/**
+ * Unmaps the vocabulary.
+ */
+VocabularyTree::~VocabularyTree()
+{
+    munmap((void *) data, fileSize);
+    ::close(fileDescriptor);
+}
+
+/**
+ * Finds the targets whose word histograms are most similar to the one of the
+ * descriptors of a frame. Only the targets in the inverted file of the words
+ * of the frame are scored. Words that occur in every target have no weight
+ * and are skipped.
+ * The scratch buffers are kept between the calls, so one VocabularyTree must
+ * not be used by several threads at once.
+ *
+ * @param descriptors the descriptors of the frame.
+ * @param count       the most candidates to return.
+ * @param candidates  is set to the candidates, the best one first.
+ */
+void VocabularyTree::shortlist(const cv::Mat & descriptors, int count, std::vector<VocabularyCandidate> & candidates)
+{
+    candidates.clear();
+    if (descriptors.empty() || descriptors.type() != CV_32F || descriptors.cols != header->descriptorLength) return;
+
+    sceneHistogram.resize(header->wordCount, 0);
+    scores.resize(header->targetCount, 0);
+
+    for (int i = 0; i < descriptors.rows; i++) {
+        int word = quantize(descriptors.ptr<float>(i));
+        if (weights[word] <= 0) continue;
+
+        if (sceneHistogram[word] == 0) sceneWords.push_back(word);
+        sceneHistogram[word] += weights[word];
+    }
+
+    float histogramSum = 0;
+    for (int i = 0; i < sceneWords.size(); i++) histogramSum += sceneHistogram[sceneWords[i]];
+
+    for (int i = 0; i < sceneWords.size(); i++) {
+        int   word   = sceneWords[i];
+        float weight = sceneHistogram[word] / histogramSum;
+
+        for (uint64_t p = postingStarts[word]; p < postingStarts[word + 1]; p++) {
+            int target = postings[p].target;
+            if (scores[target] == 0) scoredTargets.push_back(target);
+            scores[target] += std::min(weight, postings[p].weight);
+        }
+        sceneHistogram[word] = 0;
+    }
+
+    for (int i = 0; i < scoredTargets.size(); i++) {
+        candidates.push_back(VocabularyCandidate{scoredTargets[i], scores[scoredTargets[i]]});
+        scores[scoredTargets[i]] = 0;
+    }
+    sceneWords.clear();
+    scoredTargets.clear();
+
+    count = std::min(count, (int) candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](const VocabularyCandidate & a, const VocabularyCandidate & b) { return a.score > b.score; });
+    candidates.resize(count);
+}
+
+/**
+ * Turns a descriptor into the visual word of the leaf it ends up in.
+ *
+ * @param  descriptor descriptorLength floats.
+ * @return            the word.
+ */
+int VocabularyTree::quantize(const float * descriptor)
+{
+    return descend(nodes, centers, header->descriptorLength, descriptor);
+}
+
+// MARK: Getter
+
+/**
+ * Returns the number of targets the vocabulary was built from.
+ *
+ * @return target count
+ */
+int VocabularyTree::targetCount() { return header->targetCount; }
+
+/**
+ * Returns the number of visual words, i.e. the leaves of the tree.
+ *
+ * @return word count
+ */
+int VocabularyTree::wordCount() { return header->wordCount; }
+
+/**
+ * Returns the image paths of the targets, in the order of their indices.
+ *
+ * @return the paths
+ */
+std::vector<std::string> VocabularyTree::getTargetPaths()
+{
+    const char *             pathData = (const char *) (pathOffsets + header->targetCount + 1);
+    std::vector<std::string> paths;
+
+    for (int t = 0; t < header->targetCount; t++) {
+        paths.push_back(std::string(pathData + pathOffsets[t], pathOffsets[t + 1] - pathOffsets[t]));
+    }
+    return paths;
+}
+
+/**
+ * Returns the size of the mapped vocabulary, i.e. the memory the index takes
+ * up at most.
+ *
+ * @return the size in bytes
+ */
+size_t VocabularyTree::getIndexSize() { return fileSize; }
+
+/**
+ * Builds a vocabulary tree from target images and writes it to a file.
+ * The descriptors of all targets are clustered, at most
+ * VOCABULARY_TRAINING_DESCRIPTORS of them, evenly picked. A node with fewer
+ * descriptors than children becomes a leaf.
+ *
+ * @param targetImagePaths the images of the targets.
+ * @param path             where the vocabulary is written to. An existing file is overwritten.
+ * @param featureSettings  the settings the targets and frames are described with.
+ * @param branching        the children of every inner node.
+ * @param depth            the levels below the root.
+ */
+void VocabularyTree::build(std::vector<std::string> targetImagePaths, std::string path, FeatureSettings featureSettings,
+                           int branching, int depth)
+{
+    FeatureBackend backend(featureSettings);
+    if (backend.binaryDescriptors())   throw VocabularyException(path, "Binary descriptors can not be clustered");
+    if (targetImagePaths.empty())      throw VocabularyException(path, "No target images");
+    if (branching < 2 || depth < 1)    throw VocabularyException(path, "Invalid tree shape");
+
+    int targetCount = targetImagePaths.size();
+
+    // describe every target
+    std::vector<cv::Mat> targetDescriptors(targetCount);
+    long                 descriptorCount = 0;
+
+    for (int t = 0; t < targetCount; t++) {
+        cv::Mat image = cv::imread(targetImagePaths[t], CV_LOAD_IMAGE_GRAYSCALE);
+        if (!image.data) throw FileNotFoundException(targetImagePaths[t]);
+
+        std::vector<cv::KeyPoint> keypoints;
+        backend.detectAndCompute(image, keypoints, targetDescriptors[t]);
+        descriptorCount += targetDescriptors[t].rows;
+    }
+
+    // cluster them
+    long    step = std::max(1L, (descriptorCount + VOCABULARY_TRAINING_DESCRIPTORS - 1) / VOCABULARY_TRAINING_DESCRIPTORS);
+    long    row  = 0;
+    cv::Mat training;
+
+    for (int t = 0; t < targetCount; t++) {
+        for (int i = 0; i < targetDescriptors[t].rows; i++, row++) {
+            if (row % step == 0) training.push_back(targetDescriptors[t].row(i));
+        }
+    }
+    if (training.rows < branching) throw VocabularyException(path, "Too few descriptors");
+
+    std::vector<VocabularyNode> nodes(1, VocabularyNode{-1, 0, -1, 0});
+    cv::Mat                     centers = cv::Mat::zeros(1, training.cols, CV_32F);
+    int                         wordCount = 0;
+
+    cluster(training, 0, 0, branching, depth, nodes, centers, wordCount);
+
+    // count the words of every target
+    std::vector< std::vector< std::pair<int, float> > > targetWords(targetCount);
+    std::vector<int>   documentFrequency(wordCount, 0);
+    std::vector<float> termFrequency(wordCount, 0);
+    std::vector<int>   touchedWords;
+
+    for (int t = 0; t < targetCount; t++) {
+        for (int i = 0; i < targetDescriptors[t].rows; i++) {
+            int word = descend(nodes.data(), centers.ptr<float>(0), centers.cols, targetDescriptors[t].ptr<float>(i));
+            if (termFrequency[word] == 0) touchedWords.push_back(word);
+            termFrequency[word]++;
+        }
+        for (int i = 0; i < touchedWords.size(); i++) {
+            documentFrequency[touchedWords[i]]++;
+            targetWords[t].push_back(std::make_pair(touchedWords[i], termFrequency[touchedWords[i]]));
+            termFrequency[touchedWords[i]] = 0;
+        }
+        touchedWords.clear();
+    }
+
+    std::vector<float> idf(wordCount, 0);
+    for (int w = 0; w < wordCount; w++) {
+        if (documentFrequency[w] > 0) idf[w] = std::log((float) targetCount / documentFrequency[w]);
+    }
+
+    // the inverted file
+    std::vector<uint64_t> postingStarts(wordCount + 1, 0);
+
+    for (int t = 0; t < targetCount; t++) {
+        float sum = 0;
+        for (int i = 0; i < targetWords[t].size(); i++) {
+            targetWords[t][i].second *= idf[targetWords[t][i].first];
+            sum += targetWords[t][i].second;
+        }
+        for (int i = 0; i < targetWords[t].size(); i++) {
+            targetWords[t][i].second = sum > 0 ? targetWords[t][i].second / sum : 0;
+            if (targetWords[t][i].second > 0) postingStarts[targetWords[t][i].first + 1]++;
+        }
+    }
+    for (int w = 0; w < wordCount; w++) postingStarts[w + 1] += postingStarts[w];
+
+    std::vector<VocabularyPosting> postings(postingStarts[wordCount]);
+    std::vector<uint64_t>          nextPosting(postingStarts.begin(), postingStarts.end() - 1);
+
+    for (int t = 0; t < targetCount; t++) {
+        for (int i = 0; i < targetWords[t].size(); i++) {
+            if (targetWords[t][i].second <= 0) continue;
+            postings[nextPosting[targetWords[t][i].first]++] = VocabularyPosting{(uint32_t) t, targetWords[t][i].second};
+        }
+    }
+
+    std::vector<uint64_t> pathOffsets(1, 0);
+    std::string           pathData;
+    for (int t = 0; t < targetCount; t++) {
+        pathData += targetImagePaths[t];
+        pathOffsets.push_back(pathData.size());
+    }
+
+    // write the file, every section starts at a multiple of 8 bytes.
+    VocabularyHeader header = {};
+    memcpy(header.magic, VOCABULARY_MAGIC, sizeof(header.magic));
+    header.version            = VOCABULARY_VERSION;
+    header.branching          = branching;
+    header.depth              = depth;
+    header.descriptorLength   = centers.cols;
+    header.nodeCount          = nodes.size();
+    header.wordCount          = wordCount;
+    header.targetCount        = targetCount;
+    header.postingCount       = postings.size();
+    header.settingsKey        = settingsKey(featureSettings);
+
+    auto aligned = [](uint64_t offset) { return (offset + 7) / 8 * 8; };
+    header.nodeOffset         = aligned(sizeof(header));
+    header.centerOffset       = aligned(header.nodeOffset         + nodes.size() * sizeof(VocabularyNode));
+    header.weightOffset       = aligned(header.centerOffset       + centers.total() * sizeof(float));
+    header.postingStartOffset = aligned(header.weightOffset       + idf.size() * sizeof(float));
+    header.postingOffset      = aligned(header.postingStartOffset + postingStarts.size() * sizeof(uint64_t));
+    header.pathOffset         = aligned(header.postingOffset      + postings.size() * sizeof(VocabularyPosting));
+
+    FILE * file = fopen(path.c_str(), "wb");
+    if (file == NULL) throw VocabularyException(path, "Can not create vocabulary");
+
+    uint64_t written = 0;
+    auto write = [&](uint64_t offset, const void * section, size_t size) {
+        static const char padding[8] = {};
+        bool ok = fwrite(padding, 1, offset - written, file) == offset - written && fwrite(section, 1, size, file) == size;
+        written = offset + size;
+        if (!ok) {
+            fclose(file);
+            throw VocabularyException(path, "Can not write vocabulary");
+        }
+    };
+
+    write(0,                         &header,              sizeof(header));
+    write(header.nodeOffset,         nodes.data(),         nodes.size() * sizeof(VocabularyNode));
+    write(header.centerOffset,       centers.ptr<float>(0), centers.total() * sizeof(float));
+    write(header.weightOffset,       idf.data(),           idf.size() * sizeof(float));
+    write(header.postingStartOffset, postingStarts.data(), postingStarts.size() * sizeof(uint64_t));
+    write(header.postingOffset,      postings.data(),      postings.size() * sizeof(VocabularyPosting));
+    write(header.pathOffset,         pathOffsets.data(),   pathOffsets.size() * sizeof(uint64_t));
+    write(written,                   pathData.data(),      pathData.size());
+    fclose(file);
+
+    printf("VocabularyTree: %d targets, %d words, %zu postings, %llu bytes written to %s\n",
+           targetCount, wordCount, postings.size(), (unsigned long long) written, path.c_str());
+}
+
+/**
+ * Lists the images in a directory, sorted by their names.
+ *
+ * @param  directory the directory.
+ * @return           the paths of the png, jpg and bmp files in it.
+ */
+std::vector<std::string> VocabularyTree::listImages(std::string directory)
+{
+    DIR * dir = opendir(directory.c_str());
+    if (dir == NULL) throw FileNotFoundException(directory);
+
+    std::vector<std::string> paths;
+    struct dirent *          entry;
+
+    while ((entry = readdir(dir)) != NULL) {
+        std::string name = entry->d_name;
+        std::string extension = name.substr(name.find_last_of('.') + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+        if (name[0] == '.') continue;
+        if (extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "bmp") {
+            paths.push_back(directory + "/" + name);
+        }
+    }
+    closedir(dir);
+
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+/**
+ * Calculates the key that identifies the feature settings a vocabulary was
+ * built with. Frames that are described differently would end up in the
+ * wrong words.
+ *
+ * @param  featureSettings the settings.
+ * @return                 the key
+ */
+uint64_t VocabularyTree::settingsKey(FeatureSettings featureSettings)
+{
+    std::string description = FeatureBackend(featureSettings).description();
+    return TargetCache::hash(description.data(), description.size(), VOCABULARY_VERSION);
+}
+
+// MARK: PRIVATE
+
+/**
+ * Checks that the header belongs to a vocabulary and that all sections are
+ * inside of the file.
+ */
+void VocabularyTree::checkSections()
+{
+    if (memcmp(header->magic, VOCABULARY_MAGIC, sizeof(header->magic)) != 0) {
+        throw VocabularyException(path, "Not a vocabulary");
+    }
+    if (header->version != VOCABULARY_VERSION) {
+        throw VocabularyException(path, "Unsupported vocabulary version " + std::to_string(header->version));
+    }
+
+    uint64_t sectionEnds[] = {
+        header->nodeOffset         + (uint64_t) header->nodeCount * sizeof(VocabularyNode),
+        header->centerOffset       + (uint64_t) header->nodeCount * header->descriptorLength * sizeof(float),
+        header->weightOffset       + (uint64_t) header->wordCount * sizeof(float),
+        header->postingStartOffset + ((uint64_t) header->wordCount + 1) * sizeof(uint64_t),
+        header->postingOffset      + header->postingCount * sizeof(VocabularyPosting),
+        header->pathOffset         + ((uint64_t) header->targetCount + 1) * sizeof(uint64_t)
+    };
+
+    for (int i = 0; i < sizeof(sectionEnds) / sizeof(sectionEnds[0]); i++) {
+        if (sectionEnds[i] > fileSize) throw VocabularyException(path, "Vocabulary is damaged");
+    }
+    if (header->nodeCount == 0 || header->wordCount == 0) throw VocabularyException(path, "Vocabulary is empty");
+}
+
+/**
+ * Walks down the tree from the root, always to the child whose center is
+ * closest to the descriptor.
+ *
+ * @param  nodes            the nodes of the tree.
+ * @param  centers          the centers of the nodes.
+ * @param  descriptorLength the floats of every descriptor and center.
+ * @param  descriptor       the descriptor.
+ * @return                  the word of the leaf.
+ */
+int VocabularyTree::descend(const VocabularyNode * nodes, const float * centers, int descriptorLength, const float * descriptor)
+{
+    int node = 0;
+
+    while (nodes[node].firstChild >= 0) {
+        int   closest         = nodes[node].firstChild;
+        float closestDistance = FLT_MAX;
+
+        for (int child = nodes[node].firstChild; child < nodes[node].firstChild + nodes[node].childCount; child++) {
+            const float * center   = centers + (size_t) child * descriptorLength;
+            float         distance = 0;
+
+            for (int i = 0; i < descriptorLength; i++) {
+                float difference = descriptor[i] - center[i];
+                distance += difference * difference;
+            }
+            if (distance < closestDistance) {
+                closestDistance = distance;
+                closest         = child;
+            }
+        }
+        node = closest;
+    }
+
+    return nodes[node].word;
+}
+
+/**
+ * Splits the descriptors of a node into branching clusters by k-means and
+ * clusters every one of them further, until depth is reached or a cluster has
+ * fewer descriptors than children. Those nodes become the leaves.
+ *
+ * @param descriptors the descriptors that ended up in the node.
+ * @param level       the level of the node, 0 for the root.
+ * @param node        the index of the node.
+ * @param branching   the children of every inner node.
+ * @param depth       the levels below the root.
+ * @param nodes       the nodes, the children are appended.
+ * @param centers     the centers of the nodes, the ones of the children are appended.
+ * @param wordCount   the number of leaves so far.
+ */
+void VocabularyTree::cluster(const cv::Mat & descriptors, int level, int node, int branching, int depth,
+                             std::vector<VocabularyNode> & nodes, cv::Mat & centers, int & wordCount)
+{
+    if (level >= depth || descriptors.rows < branching) {
+        nodes[node].word = wordCount++;
+        return;
+    }
+
+    cv::Mat labels, clusterCenters;
+    cv::kmeans(descriptors, branching, labels,
+               cv::TermCriteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, VOCABULARY_KMEANS_ITERATIONS, 1e-4),
+               1, cv::KMEANS_PP_CENTERS, clusterCenters);
+
+    int firstChild = nodes.size();
+    nodes[node].firstChild = firstChild;
+    nodes[node].childCount = branching;
+
+    std::vector<cv::Mat> childDescriptors(branching);
+    for (int i = 0; i < descriptors.rows; i++) childDescriptors[labels.at<int>(i)].push_back(descriptors.row(i));
+
+    for (int c = 0; c < branching; c++) {
+        nodes.push_back(VocabularyNode{-1, 0, -1, 0});
+        centers.push_back(clusterCenters.row(c));
+    }
+    for (int c = 0; c < branching; c++) {
+        cluster(childDescriptors[c], level + 1, firstChild + c, branching, depth, nodes, centers, wordCount);
+    }
+}
@@ -0,0 +1,158 @@
+/*! \class VocabularyTree VocabularyTree.hpp "VocabularyTree.hpp"
+**
+** The VocabularyTree finds the few targets of a large target library that a
+** frame most likely shows, without comparing the frame with every target.
+** It is a bag of visual words: the descriptors of all targets are clustered
+** by hierarchical k-means into a tree with branching children per node and
+** depth levels. Every leaf is a visual word. A descriptor is turned into a
+** word by walking down the tree, always to the closest child, which only
+** takes branching * depth comparisons, no matter how many targets there are.
+**
+** Every target is described by how often each word occurs in it, weighted by
+** how rare the word is among all targets (tf-idf) and normalized to a sum of
+** 1. An inverted file lists for every word the targets it occurs in. A frame
+** is described the same way and scored only against the targets in the lists
+** of its words, by the intersection of the two histograms. The best scoring
+** targets are the candidates that are matched in full.
+**
+** The tree is built offline with build() and saved in a file that is mapped
+** into memory when it is read, so it does not have to be loaded and several
+** processes can share it. The file starts with a VocabularyHeader that points
+** to the sections:
+** -the nodes (VocabularyNode), the root first. The children of a node follow
+**  each other.
+** -the cluster center of every node, descriptorLength floats each.
+** -the idf weight of every word.
+** -the first posting of every word and one more entry for the end.
+** -the postings (VocabularyPosting) of all words.
+** -the offset of the image path of every target and one more entry for the
+**  end, followed by the paths.
+** All numbers are stored in the byte order of the machine that built the file.
+** Only float descriptors (surf) can be clustered.
+**
+** @version 0.1 / 17.10.2026
+*/
+
+#ifndef VOCABULARYTREE_HPP
+#define VOCABULARYTREE_HPP
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cmath>
+#include <cfloat>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "opencv2/core/core.hpp"
+#include "opencv2/highgui/highgui.hpp"
+
+#include "FeatureBackend.hpp"
+#include "TargetCache.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+
+/** The first bytes of every vocabulary file. */
+#define VOCABULARY_MAGIC "MMLVOCAB"
+/** The version of the file format. */
+#define VOCABULARY_VERSION 1
+/** At most this many descriptors are clustered, the others are only counted. */
+#define VOCABULARY_TRAINING_DESCRIPTORS 200000
+/** The k-means iterations per node. */
+#define VOCABULARY_KMEANS_ITERATIONS 10
+
+/**
+ * The header at the start of a vocabulary file. The offsets are in bytes from
+ * the start of the file.
+ */
+struct VocabularyHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t branching, depth, descriptorLength;
+    uint32_t nodeCount, wordCount, targetCount, reserved;
+    uint64_t postingCount;
+    uint64_t settingsKey; // identifies the FeatureSettings the tree was built with.
+    uint64_t nodeOffset, centerOffset, weightOffset, postingStartOffset, postingOffset, pathOffset;
+};
+
+/**
+ * A node of the tree.
+ */
+struct VocabularyNode
+{
+    int32_t firstChild; // -1 for a leaf.
+    int32_t childCount;
+    int32_t word;       // -1 for an inner node.
+    int32_t reserved;
+};
+
+/**
+ * A target that contains a word, with the weight of the word in the target.
+ */
+struct VocabularyPosting
+{
+    uint32_t target;
+    float    weight;
+};
+
+/**
+ * A target that was shortlisted for a frame. The higher the score, the more
+ * the frame looks like the target, 1 means the same histogram.
+ */
+struct VocabularyCandidate
+{
+    int   target;
+    float score;
+};
+
+class VocabularyTree {
+
+public:
+
+    VocabularyTree(std::string path, FeatureSettings featureSettings);
+    ~VocabularyTree();
+    void shortlist(const cv::Mat & descriptors, int count, std::vector<VocabularyCandidate> & candidates);
+    int  quantize(const float * descriptor);
+
+    // MARK: Getter
+    int                      targetCount();
+    int                      wordCount();
+    std::vector<std::string> getTargetPaths();
+    size_t                   getIndexSize();
+
+    static void                     build(std::vector<std::string> targetImagePaths, std::string path, FeatureSettings featureSettings,
+                                          int branching, int depth);
+    static std::vector<std::string> listImages(std::string directory);
+    static uint64_t                 settingsKey(FeatureSettings featureSettings);
+
+private:
+
+    std::string                 path;
+    int                         fileDescriptor;
+    const uchar *               data;
+    size_t                      fileSize;
+    const VocabularyHeader *    header;
+    const VocabularyNode *      nodes;
+    const float *               centers;
+    const float *               weights;
+    const uint64_t *            postingStarts;
+    const VocabularyPosting *   postings;
+    const uint64_t *            pathOffsets;
+
+    std::vector<float> sceneHistogram, scores;
+    std::vector<int>   sceneWords, scoredTargets;
+
+    void checkSections();
+
+    static int  descend(const VocabularyNode * nodes, const float * centers, int descriptorLength, const float * descriptor);
+    static void cluster(const cv::Mat & descriptors, int level, int node, int branching, int depth,
+                        std::vector<VocabularyNode> & nodes, cv::Mat & centers, int & wordCount);
+};
+
+#endif //VOCABULARYTREE_HPP
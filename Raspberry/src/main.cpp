@@ -12,6 +12,7 @@
 #include "VehicleController.hpp"
 #include "LauncherController.hpp"
 #include "VideoProcessor.hpp"
+#include "VocabularyTree.hpp"
 #include "Brain.hpp"
 #include "Properties.hpp"
 #include "Exceptions.hpp"
@@ -26,7 +27,8 @@
  */
 void usage(int argc, char *argv[]) {
     std::cout
-    << "Usage: Launcher { -a | -m | -rf }\n\n"
+    << "Usage: Launcher { -a | -m | -rf } [--headless]\n"
+    << "       Launcher --build-vocabulary <target directory> <vocabulary file>\n\n"
     << "\n"
     << "Note: Most operations require to be run in super user mode.\n"
     << "      So in case there are any exceptions during the start\n"
@@ -37,6 +39,9 @@ void usage(int argc, char *argv[]) {
     << "-m,  --manual         \tRobot will be controllable using the keyboard.\n"
     << "-r,  --reinforcement  \tRobot will seach the target using reinforcement learning.\n"
     << "-h,  --help           \tDisplay this message and exit.\n"
+    << "     --headless       \tDo not open a window or draw anything.\n"
+    << "     --build-vocabulary\tBuilds the vocabulary of all target images in a directory\n"
+    << "                      \tfor vp_target_vocabulary and exits.\n"
     << std::endl;
 }
 
@@ -72,17 +77,34 @@ int main(int argc, char *argv[]) {
         }
         */
 
-        if (argc == 2) {
+        // --headless can be given in addition to the mode.
+        bool headless = false;
+        if (argc == 3 && std::string(argv[2]) == "--headless") {
+            headless = true;
+            argc     = 2;
+        } else if (argc == 3 && std::string(argv[1]) == "--headless") {
+            headless = true;
+            argv[1]  = argv[2];
+            argc     = 2;
+        }
+
+        if (argc == 4 && std::string(argv[1]) == "--build-vocabulary") {
+            Properties * properties = Properties::getInstance();
+            VocabularyTree::build(VocabularyTree::listImages(argv[2]), argv[3], VideoProcessor::featureSettingsFromProperties(),
+                                  properties->getNumberPropertyWithName("vp_vocabulary_branching"),
+                                  properties->getNumberPropertyWithName("vp_vocabulary_depth"));
+        }
+        else if (argc == 2) {
             if      (std::string(argv[1]) == "-a"   || std::string(argv[1]) == "--autonomous") {
-                Brain * brain = new Brain();
+                Brain * brain = new Brain(headless);
                 brain->stateMachineLoop();
             }
             else if (std::string(argv[1]) == "-m"   || std::string(argv[1]) == "--manual") {
-                Brain * brain = new Brain();
+                Brain * brain = new Brain(headless);
                 brain->startSDLControlWindow();
             }
             else if (std::string(argv[1]) == "-r"  || std::string(argv[1]) == "--reinforcement") {
-                Brain * brain = new Brain();
+                Brain * brain = new Brain(headless);
                 brain->startReinforcementLearning();
             }
             else if (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help") {